@@ -0,0 +1,28 @@
+﻿#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Entity/Entity.h"
+#include "TypeInformation/TypeInfoGenerator.h"
+
+/**
+ * Places the Transform of an entity relative to the Transform of its parent.
+ * The world Transform of the entity is computed from its local transform by the HierarchyTransformSystem.
+ * The depth has to be one more than the depth of the parent, entities without a parent have depth 0.
+ * The depth has to be updated when the entity is given a different parent, debug builds assert this while computing the Transforms.
+ */
+struct Hierarchy
+{
+	entityId parent{ Entity::InvalidId };
+	uint32_t depth{};
+
+	glm::mat3 local{
+		1,0,0,
+		0,1,0,
+		0,0,1 };
+};
+
+/** Sorts the entities breadth-first, the parents of a depth level are always in front of it*/
+inline bool SortCompare(const Hierarchy& hierarchy0, const Hierarchy& hierarchy1) { return hierarchy0.depth < hierarchy1.depth; }
+
+inline RegisterClass<Hierarchy> HierarchyReg;
@@ -68,4 +68,7 @@ struct Transform
 	}
 };
 
+/** The translation of the transform, used by the SpatialIndex of Transform*/
+inline glm::vec2 SpatialPosition(const Transform& transform) { return { transform.transform[2][0], transform.transform[2][1] }; }
+
 inline RegisterClass<Transform> TransformReg;
\ No newline at end of file
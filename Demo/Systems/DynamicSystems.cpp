@@ -1,4 +1,7 @@
 ﻿#include "DynamicSystems.h"
+
+#include <cassert>
+
 #include "../Components/RenderModifiers.h"
 #include "../Components/TransformModifiers.h"
 #include "../Components/TestClasses.h"
@@ -15,6 +18,62 @@ void RenderTransformUpdateSystem::Execute()
 
 RegisterSystem<RenderTransformUpdateSystem> renderTransformUpdateSystem(SystemParameters{ "RenderTransformUpdate2", int32_t(ExecutionTime::LateUpdate) });
 
+void HierarchyTransformSystem::Execute()
+{
+	TypeBinding* binding{ GetTypeBinding() };
+	binding->Sort<Hierarchy>();
+
+	const size_t size{ binding->GetSize() };
+	const size_t hierarchyPos{ binding->GetTypePos<Hierarchy>() };
+	const size_t transformPos{ binding->GetTypePos<Transform>() };
+	const size_t typesAmount{ binding->GetTypeAmount() };
+
+	m_ParentPositions.resize(size, NoParent);
+
+	size_t levelBegin{};
+	while (levelBegin < size)
+	{
+		const uint32_t depth{ binding->GetPointer<Hierarchy>(hierarchyPos, levelBegin)->depth };
+		size_t levelEnd{ levelBegin + 1 };
+		while (levelEnd < size && binding->GetPointer<Hierarchy>(hierarchyPos, levelEnd)->depth == depth)
+			++levelEnd;
+
+		ForEachChunk(binding->GetIndices() + levelBegin * typesAmount, binding->GetElementStride(), levelEnd - levelBegin,
+			[this, binding, levelBegin, hierarchyPos, transformPos](size_t begin, size_t end)
+			{
+				const auto& elementEntities = binding->GetElementEntities();
+				for (size_t i{ levelBegin + begin }; i < levelBegin + end; ++i)
+				{
+					const Hierarchy& hierarchy{ *binding->GetPointer<Hierarchy>(hierarchyPos, i) };
+					Transform& transform{ *binding->GetPointer<Transform>(transformPos, i) };
+
+					// The position from the previous execution is used as long as the binding still has the parent there
+					size_t& parentPos{ m_ParentPositions[i] };
+					if (hierarchy.parent != Entity::InvalidId && (parentPos >= elementEntities.size() || elementEntities[parentPos] != hierarchy.parent))
+					{
+						// A parent without a Hierarchy is treated the same as no parent
+						const auto& entities = binding->GetEntities();
+						auto parent = entities.find(hierarchy.parent);
+						parentPos = (parent != entities.end()) ? parent->second : NoParent;
+					}
+
+					if (hierarchy.parent == Entity::InvalidId || parentPos == NoParent)
+					{
+						transform.transform = hierarchy.local;
+						continue;
+					}
+
+					assert(binding->GetPointer<Hierarchy>(hierarchyPos, parentPos)->depth + 1 == hierarchy.depth && "The depth of a Hierarchy has to be one more than the depth of its parent");
+					transform.transform = binding->GetPointer<Transform>(transformPos, parentPos)->transform * hierarchy.local;
+				}
+			});
+
+		levelBegin = levelEnd;
+	}
+}
+
+RegisterSystem<HierarchyTransformSystem> hierarchyTransformSystem(SystemParameters{ "HierarchyTransform", int32_t(ExecutionTime::LateUpdate) - 2, 0.f, true });
+
 
 RegisterDynamicSystem<Render, Transform> renderTransformTransfer(
 	SystemParameters{ "RenderTransformUpdate", int32_t(ExecutionTime::LateUpdate) },
@@ -37,7 +96,7 @@ RegisterDynamicSystem<Render, RenderModifiers> renderModifiers(
 	});
 
 RegisterDynamicSystem<Transform, MoveScaleRotate> moveScaleRotate(
-	SystemParameters{ "MoveScaleRotate" },
+	SystemParameters{ "MoveScaleRotate", int32_t(ExecutionTime::Update), 0.f, true },
 	[](Transform& transform, MoveScaleRotate& msr)
 	{
 		transform.Move(msr.deltaPos);
@@ -45,7 +104,7 @@ RegisterDynamicSystem<Transform, MoveScaleRotate> moveScaleRotate(
 	});
 
 RegisterDynamicSystem<Transform> posModular(
-	SystemParameters{ "PositionModulo", int32_t(ExecutionTime::LateUpdate) - 1, 0.1f },
+	SystemParameters{ "PositionModulo", int32_t(ExecutionTime::LateUpdate) - 1, 0.1f, true },
 	[](Transform& transform)
 	{
 		transform.transform[2][0] = std::fmod(transform.transform[2][0] + 1280.f, 1280.f);
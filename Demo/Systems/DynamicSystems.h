@@ -1,6 +1,10 @@
 #pragma once
+#include <limits>
+#include <vector>
+
 #include "../Components/Render.h"
 #include "../Components/Transform.h"
+#include "../Components/Hierarchy.h"
 
 class RenderTransformUpdateSystem final : public BindingSystem<Render, Transform>
 {
@@ -13,3 +17,29 @@ public:
 
 	void Execute() override;
 };
+
+/**
+ * Computes the world Transform of the entities in a Hierarchy from their local transform and the world Transform of their parent.
+ * The binding is sorted breadth-first by depth, so every depth level is a contiguous range of which the parents were computed by the previous level.
+ * The elements of a depth level do not depend on each other and are split over the workers when the system is parallel.
+ * The position of the parent of every element inside of the binding is kept between executions and only looked up again when the binding was reordered or the parent changed.
+ * When Hierarchy and Transform are an owning group the Components themselves are kept in this order, so every level is a linear pass over both arrays.
+ */
+class HierarchyTransformSystem final : public BindingSystem<Hierarchy, Transform>
+{
+public:
+
+	HierarchyTransformSystem(const SystemParameters& parameters) : BindingSystem<Hierarchy, Transform>(parameters) {}
+	~HierarchyTransformSystem() override = default;
+
+public:
+
+	void Execute() override;
+
+private:
+
+	constexpr static size_t NoParent{ std::numeric_limits<size_t>::max() };
+
+	/** The position of the parent of every element inside of the binding, NoParent when the parent is not inside of the binding*/
+	std::vector<size_t> m_ParentPositions;
+};
@@ -10,6 +10,8 @@
 
 #include <SDL.h>
 
+#include <chrono>
+
 #include "GUI_main.h"
 
 #define REGISTRY_DESERIALIZE
@@ -62,6 +64,9 @@ int main(int, char* [])
 	}
 #else
 
+	// Keeps Render and Transform in the same order so RenderTransformUpdate iterates both arrays linearly
+	registry.AddGroup<Render, Transform>();
+
 	registry.AddSystem("RenderingSystem");
 	registry.AddSystem("RenderTransformUpdate");
 	registry.AddSystem("RenderModifier");
@@ -69,23 +74,39 @@ int main(int, char* [])
 	registry.AddSystem("PositionModulo");
 	registry.AddSystem("BaseClassNamePrinter");
 
-	std::vector<GameObject> objects;
+	const auto creationBegin = std::chrono::high_resolution_clock::now();
+
 	constexpr size_t entitiesAmount{ 16'384 };
-	objects.reserve(entitiesAmount);
+	std::vector<entityId> entities(entitiesAmount);
+	registry.CreateEntities(entitiesAmount, entities.data());
+
+	std::vector<Render> renders(entitiesAmount);
+	std::vector<Transform> transforms(entitiesAmount);
+	std::vector<MoveScaleRotate> transformMods(entitiesAmount);
+	std::vector<RenderModifiers> renderMods(entitiesAmount);
 	for (size_t i{}; i < entitiesAmount; ++i)
 	{
-		auto& object = objects.emplace_back(registry);
-		auto render = object.AddComponent<Render>();
-		auto transform = object.AddComponent<Transform>();
-		auto transformMod = object.AddComponent<MoveScaleRotate>();
-		auto renderMod = object.AddComponent<RenderModifiers>();
-
-		transformMod->Randomize();
-		renderMod->Randomize();
-		transform->Randomize();
-		render->Randomize();
+		transformMods[i].Randomize();
+		renderMods[i].Randomize();
+		transforms[i].Randomize();
+		renders[i].Randomize();
 	}
 
+	// Every view grows once and the group is only updated after all Components of a view were added
+	registry.AddComponents<Render>(entities, renders);
+	registry.AddComponents<Transform>(entities, transforms);
+	registry.AddComponents<MoveScaleRotate>(entities, transformMods);
+	registry.AddComponents<RenderModifiers>(entities, renderMods);
+
+	const auto creationEnd = std::chrono::high_resolution_clock::now();
+	std::cout << "Created " << entitiesAmount << " entities in " << std::chrono::duration<float, std::milli>(creationEnd - creationBegin).count() << "ms\n";
+
+	// The game objects remove their entity from the registry when they are destroyed
+	std::vector<GameObject> objects;
+	objects.reserve(entitiesAmount);
+	for (entityId id : entities)
+		objects.emplace_back(registry, id);
+
 	objects[0].AddComponent<BaseClass>();
 	objects[1].AddComponent<DerivedClass>();
 	objects[2].AddComponent<UpdateAbleClass>();
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "HugePages.h"
+
+/** Allocates arrays starting on an Alignment byte boundary, a cache line by default so SIMD kernels can use aligned loads*/
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator
+{
+	static_assert((Alignment & (Alignment - 1)) == 0, "The alignment has to be a power of 2");
+
+public:
+
+	using value_type = T;
+
+	template <typename U>
+	struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+	AlignedAllocator() = default;
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ GetAlignment() })); }
+	void deallocate(T* pMemory, size_t) noexcept { ::operator delete(pMemory, std::align_val_t{ GetAlignment() }); }
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+private:
+
+	constexpr static size_t GetAlignment() { return std::max(Alignment, alignof(T)); }
+};
+
+/**
+ * Allocates arrays of at least HugePages::PageSize bytes in huge pages (see HugePages.h) and smaller arrays like the AlignedAllocator.
+ * Meant for views of millions of Components, the memory of a view is only returned to the system when the view shrinks or is destroyed.
+ */
+template <typename T, size_t Alignment = 64>
+class HugePageAllocator
+{
+public:
+
+	using value_type = T;
+
+	template <typename U>
+	struct rebind { using other = HugePageAllocator<U, Alignment>; };
+
+	HugePageAllocator() = default;
+
+	template <typename U>
+	HugePageAllocator(const HugePageAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(size_t n)
+	{
+		if (n * sizeof(T) >= HugePages::PageSize)
+			return static_cast<T*>(HugePages::Allocate(n * sizeof(T)));
+		return AlignedAllocator<T, Alignment>{}.allocate(n);
+	}
+
+	void deallocate(T* pMemory, size_t n) noexcept
+	{
+		if (n * sizeof(T) >= HugePages::PageSize)
+			HugePages::Free(pMemory, n * sizeof(T));
+		else
+			AlignedAllocator<T, Alignment>{}.deallocate(pMemory, n);
+	}
+
+	template <typename U>
+	bool operator==(const HugePageAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+/** Memory resource placing the allocations of at least HugePages::PageSize bytes in huge pages, to be used with std::pmr::polymorphic_allocator*/
+class HugePageResource final : public std::pmr::memory_resource
+{
+private:
+
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		if (bytes >= HugePages::PageSize)
+			return HugePages::Allocate(bytes);
+		return ::operator new(bytes, std::align_val_t{ alignment });
+	}
+
+	void do_deallocate(void* pMemory, size_t bytes, size_t alignment) override
+	{
+		if (bytes >= HugePages::PageSize)
+			HugePages::Free(pMemory, bytes);
+		else
+			::operator delete(pMemory, std::align_val_t{ alignment });
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+/**
+ * The allocator of the array of Components inside of a TypeView, the AlignedAllocator by default.
+ * A Component chooses its allocator by declaring `using Allocator = HugePageAllocator<Component>;`,
+ * allocators that need state like std::pmr::polymorphic_allocator are returned by a static CreateAllocator() function of the Component instead.
+ * The allocator of types that can not be changed is chosen by specializing ComponentAllocatorType.
+ */
+template <typename Component>
+struct ComponentAllocatorType
+{
+	using type = AlignedAllocator<Component>;
+	static type Create() { return type{}; }
+};
+
+template <typename Component> requires requires { Component::CreateAllocator(); }
+struct ComponentAllocatorType<Component>
+{
+	using type = typename std::allocator_traits<decltype(Component::CreateAllocator())>::template rebind_alloc<Component>;
+	static type Create() { return type(Component::CreateAllocator()); }
+};
+
+template <typename Component> requires requires { typename Component::Allocator; } && (!requires { Component::CreateAllocator(); })
+struct ComponentAllocatorType<Component>
+{
+	using type = typename std::allocator_traits<typename Component::Allocator>::template rebind_alloc<Component>;
+	static type Create() { return type{}; }
+};
+
+template <typename Component>
+using ComponentAllocator = typename ComponentAllocatorType<Component>::type;
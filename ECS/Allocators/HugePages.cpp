@@ -0,0 +1,70 @@
+#include "HugePages.h"
+
+#include <cstdint>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+void* HugePages::Allocate(size_t size)
+{
+	const size_t bytes{ RoundUp(size) };
+
+#ifdef _WIN32
+	const size_t largePageSize{ GetLargePageMinimum() };
+	if (largePageSize && bytes % largePageSize == 0)
+	{
+		if (void* pMemory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+			return pMemory;
+	}
+
+	if (void* pMemory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE))
+		return pMemory;
+
+	throw std::bad_alloc();
+#else
+#ifdef MAP_HUGETLB
+	void* pHuge{ mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) };
+	if (pHuge != MAP_FAILED)
+		return pHuge;
+#endif
+
+	// Transparent huge pages only back ranges aligned to a huge page, so an extra page is mapped and the unaligned ends are unmapped
+	void* pMapped{ mmap(nullptr, bytes + PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+	if (pMapped == MAP_FAILED)
+		throw std::bad_alloc();
+
+	const uintptr_t address{ reinterpret_cast<uintptr_t>(pMapped) };
+	const uintptr_t aligned{ (address + PageSize - 1) / PageSize * PageSize };
+	const size_t head{ aligned - address };
+
+	if (head)
+		munmap(pMapped, head);
+	if (PageSize - head)
+		munmap(reinterpret_cast<void*>(aligned + bytes), PageSize - head);
+
+#ifdef MADV_HUGEPAGE
+	madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+
+	return reinterpret_cast<void*>(aligned);
+#endif
+}
+
+void HugePages::Free(void* pMemory, size_t size)
+{
+	if (!pMemory)
+		return;
+
+#ifdef _WIN32
+	(void)size;
+	VirtualFree(pMemory, 0, MEM_RELEASE);
+#else
+	munmap(pMemory, RoundUp(size));
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * Memory backed by huge pages, so iterating millions of Components touches far fewer pages and needs far fewer TLB entries.
+ * On Linux reserved huge pages (MAP_HUGETLB) are used when available, otherwise the memory is aligned to a huge page and marked for transparent huge pages.
+ * On Windows large pages are used when the process holds the SeLockMemoryPrivilege, otherwise regular pages are committed.
+ */
+namespace HugePages
+{
+	constexpr size_t PageSize{ 2 * 1024 * 1024 };
+
+	/** Returns the size rounded up to a multiple of PageSize*/
+	constexpr size_t RoundUp(size_t size) { return (size + PageSize - 1) / PageSize * PageSize; }
+
+	/**
+	 * Maps at least size bytes, starting on a page boundary.
+	 * @throws std::bad_alloc: when no memory could be mapped
+	 */
+	void* Allocate(size_t size);
+
+	/** Unmaps memory returned by Allocate, size has to be the size it was allocated with*/
+	void Free(void* pMemory, size_t size);
+}
@@ -0,0 +1,56 @@
+#include "VirtualMemory.h"
+#include "HugePages.h"
+
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+void* VirtualMemory::Reserve(size_t size)
+{
+#ifdef _WIN32
+	if (void* pMemory = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS))
+		return pMemory;
+	throw std::bad_alloc();
+#else
+	void* pMemory{ mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0) };
+	if (pMemory == MAP_FAILED)
+		throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+	if (size >= HugePages::PageSize)
+		madvise(pMemory, size, MADV_HUGEPAGE);
+#endif
+
+	return pMemory;
+#endif
+}
+
+void VirtualMemory::Commit(void* pMemory, size_t size)
+{
+#ifdef _WIN32
+	if (!VirtualAlloc(pMemory, size, MEM_COMMIT, PAGE_READWRITE))
+		throw std::bad_alloc();
+#else
+	if (mprotect(pMemory, size, PROT_READ | PROT_WRITE) != 0)
+		throw std::bad_alloc();
+#endif
+}
+
+void VirtualMemory::Release(void* pMemory, size_t size)
+{
+	if (!pMemory)
+		return;
+
+#ifdef _WIN32
+	(void)size;
+	VirtualFree(pMemory, 0, MEM_RELEASE);
+#else
+	munmap(pMemory, size);
+#endif
+}
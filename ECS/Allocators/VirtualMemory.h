@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * Reserving address space and committing memory inside of it on demand.
+ * Memory committed inside of a reservation never moves, so an array placed in a reservation can grow without copying its elements.
+ */
+namespace VirtualMemory
+{
+	/**
+	 * Reserves size bytes of address space without using memory, reservations of a huge page or more are marked for transparent huge pages on Linux.
+	 * @throws std::bad_alloc: when the address space could not be reserved
+	 */
+	void* Reserve(size_t size);
+
+	/**
+	 * Makes the bytes [pMemory, pMemory + size) of a reservation readable and writable, pMemory and size have to be multiples of the page size.
+	 * @throws std::bad_alloc: when the memory could not be committed
+	 */
+	void Commit(void* pMemory, size_t size);
+
+	/** Releases a reservation together with the memory committed inside of it, size has to be the size it was reserved with*/
+	void Release(void* pMemory, size_t size);
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DenseArray.h"
+
+/**
+ * The tick at which every element of a TypeView was added and last changed, stored at the same position as the element.
+ * The elements are also split up in chunks of ChunkSize elements that store the highest tick of their elements,
+ * so iterating the elements that changed since a tick can skip whole chunks using a single comparison.
+ * The highest tick of a chunk may be higher than the ticks of its elements after elements moved out of it, it is never lower.
+ * The ticks of the elements can be kept in PagedArrays using SetMaxSize, so they are never copied when they grow.
+ */
+class ChangeTicks final
+{
+public:
+
+	/** 64 bit so the tick of a registry never wraps around, which would make old elements look newer than the tick of a query*/
+	using Tick = uint64_t;
+
+	constexpr static size_t ChunkSize{ 1024 };
+
+public:
+
+	/** Keeps the ticks of the elements in PagedArrays of maxSize elements from now on, there may not be any elements yet*/
+	void SetMaxSize(size_t maxSize)
+	{
+		m_Added.SetMaxSize(maxSize);
+		m_Changed.SetMaxSize(maxSize);
+	}
+
+	/** Adds an element that was added and changed at the given tick at the back*/
+	void push_back(Tick tick)
+	{
+		m_Added.emplace_back(tick);
+		m_Changed.emplace_back(tick);
+		UpdateChunk(m_AddedChunks, m_Added.size() - 1, tick);
+		UpdateChunk(m_ChangedChunks, m_Changed.size() - 1, tick);
+	}
+
+	void pop_back()
+	{
+		assert(!m_Added.empty());
+		m_Added.pop_back();
+		m_Changed.pop_back();
+
+		const size_t chunks{ GetChunkAmount(m_Added.size()) };
+		m_AddedChunks.resize(chunks);
+		m_ChangedChunks.resize(chunks);
+	}
+
+	void SwapPositions(size_t pos0, size_t pos1)
+	{
+		std::swap(m_Added[pos0], m_Added[pos1]);
+		std::swap(m_Changed[pos0], m_Changed[pos1]);
+		UpdateChunk(m_AddedChunks, pos0, m_Added[pos0]);
+		UpdateChunk(m_AddedChunks, pos1, m_Added[pos1]);
+		UpdateChunk(m_ChangedChunks, pos0, m_Changed[pos0]);
+		UpdateChunk(m_ChangedChunks, pos1, m_Changed[pos1]);
+	}
+
+	void SetChanged(size_t pos, Tick tick)
+	{
+		m_Changed[pos] = tick;
+		UpdateChunk(m_ChangedChunks, pos, tick);
+	}
+
+	/** Marks every element as changed at the given tick*/
+	void SetAllChanged(Tick tick)
+	{
+		std::fill(m_Changed.begin(), m_Changed.end(), tick);
+		std::fill(m_ChangedChunks.begin(), m_ChangedChunks.end(), tick);
+	}
+
+	/** Gives the elements their new position, the element at position i moves to the position order[i]*/
+	void Reorder(const size_t* order);
+
+	/** Replaces the ticks by size elements that were added and changed at the given tick*/
+	void Assign(size_t size, Tick tick);
+
+	void reserve(size_t size)
+	{
+		m_Added.reserve(size);
+		m_Changed.reserve(size);
+	}
+
+	size_t size() const { return m_Added.size(); }
+
+	Tick GetAdded(size_t pos) const { return m_Added[pos]; }
+	Tick GetChanged(size_t pos) const { return m_Changed[pos]; }
+
+	const Tick* GetAddedTicks() const { return m_Added.data(); }
+	const Tick* GetChangedTicks() const { return m_Changed.data(); }
+
+	/** The highest tick at which an element of the chunk was added or changed*/
+	Tick GetChunkAdded(size_t chunk) const { return m_AddedChunks[chunk]; }
+	Tick GetChunkChanged(size_t chunk) const { return m_ChangedChunks[chunk]; }
+
+	static size_t GetChunkAmount(size_t size) { return (size + ChunkSize - 1) / ChunkSize; }
+
+private:
+
+	static void UpdateChunk(std::vector<Tick>& chunks, size_t pos, Tick tick)
+	{
+		const size_t chunk{ pos / ChunkSize };
+		if (chunk >= chunks.size())
+			chunks.resize(chunk + 1);
+
+		chunks[chunk] = std::max(chunks[chunk], tick);
+	}
+
+	static void ComputeChunks(std::vector<Tick>& chunks, const DenseArray<Tick>& ticks);
+
+private:
+
+	DenseArray<Tick> m_Added;
+	DenseArray<Tick> m_Changed;
+
+	std::vector<Tick> m_AddedChunks;
+	std::vector<Tick> m_ChangedChunks;
+};
+
+inline void ChangeTicks::Reorder(const size_t* order)
+{
+	std::vector<Tick> added(m_Added.size());
+	std::vector<Tick> changed(m_Changed.size());
+	for (size_t i{}; i < m_Added.size(); ++i)
+	{
+		added[order[i]] = m_Added[i];
+		changed[order[i]] = m_Changed[i];
+	}
+	m_Added.assign(added.data(), added.data() + added.size());
+	m_Changed.assign(changed.data(), changed.data() + changed.size());
+
+	ComputeChunks(m_AddedChunks, m_Added);
+	ComputeChunks(m_ChangedChunks, m_Changed);
+}
+
+inline void ChangeTicks::Assign(size_t size, Tick tick)
+{
+	m_Added.assign(size, tick);
+	m_Changed.assign(size, tick);
+	m_AddedChunks.assign(GetChunkAmount(size), tick);
+	m_ChangedChunks.assign(GetChunkAmount(size), tick);
+}
+
+inline void ChangeTicks::ComputeChunks(std::vector<Tick>& chunks, const DenseArray<Tick>& ticks)
+{
+	chunks.assign(GetChunkAmount(ticks.size()), 0);
+	for (size_t i{}; i < ticks.size(); ++i)
+		chunks[i / ChunkSize] = std::max(chunks[i / ChunkSize], ticks[i]);
+}
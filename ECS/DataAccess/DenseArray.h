@@ -0,0 +1,108 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "PagedArray.h"
+
+/**
+ * Contiguous array of trivially copyable elements stored either in a std::vector or in a PagedArray.
+ * Used for the arrays a TypeViewBase keeps next to the data array of the view (the entities and the change ticks),
+ * so the views of Components with a MaxComponents can keep those in reserved address space as well (see PagedStorable).
+ * Reading the elements does not depend on the storage, only the functions that change the size do.
+ */
+template <typename T>
+class DenseArray final
+{
+	static_assert(std::is_trivially_copyable_v<T>, "The elements of a DenseArray have to be trivially copyable");
+
+public:
+
+	DenseArray() = default;
+
+	/** The elements of a PagedArray can be pointed to*/
+	DenseArray(const DenseArray&) = delete;
+	DenseArray(DenseArray&&) = delete;
+	DenseArray& operator=(const DenseArray&) = delete;
+	DenseArray& operator=(DenseArray&&) = delete;
+
+public:
+
+	/** Stores the elements in a PagedArray of maxSize elements from now on, so they are never copied when the array grows. The array has to be empty*/
+	void SetMaxSize(size_t maxSize)
+	{
+		assert(empty() && !m_pPaged);
+		std::vector<T>{}.swap(m_Vector);
+		m_pPaged = std::make_unique<PagedArray<T>>(maxSize);
+		Update();
+	}
+
+	bool IsPaged() const { return m_pPaged != nullptr; }
+
+	size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+	size_t capacity() const { return m_pPaged ? m_pPaged->capacity() : m_Vector.capacity(); }
+
+	T* data() { return m_pData; }
+	const T* data() const { return m_pData; }
+
+	T* begin() { return m_pData; }
+	T* end() { return m_pData + m_Size; }
+	const T* begin() const { return m_pData; }
+	const T* end() const { return m_pData + m_Size; }
+
+	T& operator[](size_t pos) { assert(pos < m_Size); return m_pData[pos]; }
+	const T& operator[](size_t pos) const { assert(pos < m_Size); return m_pData[pos]; }
+
+	T& back() { assert(m_Size); return m_pData[m_Size - 1]; }
+	const T& back() const { assert(m_Size); return m_pData[m_Size - 1]; }
+
+	void reserve(size_t capacity) { Modify([capacity](auto& array) { array.reserve(capacity); }); }
+
+	void emplace_back(T value) { Modify([value](auto& array) { array.emplace_back(value); }); }
+
+	void pop_back() { assert(m_Size); Modify([](auto& array) { array.pop_back(); }); }
+
+	void clear() { Modify([](auto& array) { array.clear(); }); }
+
+	/** Replaces the elements by the elements [first, last)*/
+	void assign(const T* first, const T* last) { Modify([first, last](auto& array) { array.assign(first, last); }); }
+
+	/** Replaces the elements by size copies of the value*/
+	void assign(size_t size, T value)
+	{
+		Modify([size, value](auto& array)
+			{
+				array.clear();
+				array.insert(array.end(), size, value);
+			});
+	}
+
+private:
+
+	template <typename Function>
+	void Modify(const Function& function)
+	{
+		if (m_pPaged)
+			function(*m_pPaged);
+		else
+			function(m_Vector);
+		Update();
+	}
+
+	void Update()
+	{
+		m_pData = m_pPaged ? m_pPaged->data() : m_Vector.data();
+		m_Size = m_pPaged ? m_pPaged->size() : m_Vector.size();
+	}
+
+private:
+
+	std::vector<T> m_Vector;
+	std::unique_ptr<PagedArray<T>> m_pPaged;
+
+	T* m_pData{};
+	size_t m_Size{};
+};
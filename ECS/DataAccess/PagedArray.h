@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../Allocators/VirtualMemory.h"
+
+/**
+ * Contiguous array that never moves its elements, used as the data array of TypeViews of Components with a MaxComponents (see PagedStorable).
+ * Address space for maxSize elements is reserved up front and pages of CommitSize bytes are committed as the array grows,
+ * so growing never copies the elements and pointers to them stay valid until they are removed.
+ * Only the pages that were committed use memory. Elements can only be added and removed at the back.
+ */
+template <typename T>
+class PagedArray final
+{
+public:
+
+	constexpr static size_t CommitSize{ 64 * 1024 };
+
+public:
+
+	explicit PagedArray(size_t maxSize)
+		: m_MaxSize{ maxSize }
+		, m_ReservedBytes{ RoundUp(maxSize * sizeof(T)) }
+		, m_pData{ static_cast<T*>(VirtualMemory::Reserve(m_ReservedBytes)) }
+	{}
+
+	~PagedArray()
+	{
+		clear();
+		VirtualMemory::Release(m_pData, m_ReservedBytes);
+	}
+
+	PagedArray(const PagedArray&) = delete;
+	PagedArray(PagedArray&&) = delete;
+	PagedArray& operator=(const PagedArray&) = delete;
+	PagedArray& operator=(PagedArray&&) = delete;
+
+public:
+
+	size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+
+	/** The amount of elements that fit inside of the committed pages*/
+	size_t capacity() const { return m_Capacity; }
+
+	/** The amount of elements the address space was reserved for*/
+	size_t max_size() const { return m_MaxSize; }
+
+	T* data() { return m_pData; }
+	const T* data() const { return m_pData; }
+
+	T* begin() { return m_pData; }
+	T* end() { return m_pData + m_Size; }
+	const T* begin() const { return m_pData; }
+	const T* end() const { return m_pData + m_Size; }
+
+	T& operator[](size_t pos) { assert(pos < m_Size); return m_pData[pos]; }
+	const T& operator[](size_t pos) const { assert(pos < m_Size); return m_pData[pos]; }
+
+	T& front() { assert(m_Size); return m_pData[0]; }
+	T& back() { assert(m_Size); return m_pData[m_Size - 1]; }
+	const T& front() const { assert(m_Size); return m_pData[0]; }
+	const T& back() const { assert(m_Size); return m_pData[m_Size - 1]; }
+
+	/** Commits the pages for at least capacity elements, or for max_size() elements when capacity is bigger*/
+	void reserve(size_t capacity);
+
+	template <typename... Arguments>
+	T& emplace_back(Arguments&&... arguments);
+
+	void pop_back()
+	{
+		assert(m_Size);
+		std::destroy_at(m_pData + --m_Size);
+	}
+
+	/** Default constructs or destroys elements at the back until the array contains size elements*/
+	void resize(size_t size);
+
+	void clear()
+	{
+		std::destroy(begin(), end());
+		m_Size = 0;
+	}
+
+	/** Appends amount copies of the value, elements can only be inserted at the back*/
+	void insert(const T* pos, size_t amount, const T& value);
+
+	/** Appends the elements [first, last), elements can only be inserted at the back*/
+	template <typename Iterator>
+	void insert(const T* pos, Iterator first, Iterator last);
+
+	template <typename Iterator>
+	void assign(Iterator first, Iterator last)
+	{
+		clear();
+		insert(end(), first, last);
+	}
+
+private:
+
+	static size_t RoundUp(size_t bytes) { return std::max((bytes + CommitSize - 1) / CommitSize * CommitSize, CommitSize); }
+
+	/** Makes sure amount more elements fit, throws when the array would exceed its max_size()*/
+	void Grow(size_t amount);
+
+private:
+
+	size_t m_MaxSize{};
+	size_t m_ReservedBytes{};
+	T* m_pData{};
+
+	size_t m_Size{};
+	size_t m_Capacity{};
+	size_t m_CommittedBytes{};
+};
+
+template <typename T>
+void PagedArray<T>::reserve(size_t capacity)
+{
+	capacity = std::min(capacity, m_MaxSize);
+	if (capacity <= m_Capacity)
+		return;
+
+	const size_t committedBytes{ std::min(RoundUp(capacity * sizeof(T)), m_ReservedBytes) };
+	VirtualMemory::Commit(reinterpret_cast<std::byte*>(m_pData) + m_CommittedBytes, committedBytes - m_CommittedBytes);
+
+	m_CommittedBytes = committedBytes;
+	m_Capacity = std::min(m_CommittedBytes / sizeof(T), m_MaxSize);
+}
+
+template <typename T>
+template <typename... Arguments>
+T& PagedArray<T>::emplace_back(Arguments&&... arguments)
+{
+	Grow(1);
+	T* pElement{ std::construct_at(m_pData + m_Size, std::forward<Arguments>(arguments)...) };
+	++m_Size;
+	return *pElement;
+}
+
+template <typename T>
+void PagedArray<T>::resize(size_t size)
+{
+	if (size < m_Size)
+	{
+		std::destroy(m_pData + size, end());
+		m_Size = size;
+		return;
+	}
+
+	Grow(size - m_Size);
+	std::uninitialized_value_construct(end(), m_pData + size);
+	m_Size = size;
+}
+
+template <typename T>
+void PagedArray<T>::insert(const T* pos, size_t amount, const T& value)
+{
+	assert(pos == end());
+	(void)pos;
+
+	Grow(amount);
+	std::uninitialized_fill_n(end(), amount, value);
+	m_Size += amount;
+}
+
+template <typename T>
+template <typename Iterator>
+void PagedArray<T>::insert(const T* pos, Iterator first, Iterator last)
+{
+	assert(pos == end());
+	(void)pos;
+
+	const size_t amount{ size_t(std::distance(first, last)) };
+	Grow(amount);
+	std::uninitialized_copy(first, last, end());
+	m_Size += amount;
+}
+
+template <typename T>
+void PagedArray<T>::Grow(size_t amount)
+{
+	if (m_Size + amount <= m_Capacity)
+		return;
+
+	if (m_Size + amount > m_MaxSize)
+		throw std::length_error("The array can not hold more than " + std::to_string(m_MaxSize) + " elements");
+
+	reserve(std::max(m_Size + amount, m_Capacity * 2));
+}
@@ -67,6 +67,26 @@ public:
 	Reference(ReferencePointer<T>* ptr) : m_ReferencePointer{ ptr } { if (ptr) ++ptr->m_Counter; }
 	~Reference() { if (m_ReferencePointer) --m_ReferencePointer->m_Counter; }
 
+	Reference(const Reference& other) : Reference(other.m_ReferencePointer) {}
+	Reference(Reference&& other) noexcept : m_ReferencePointer{ other.m_ReferencePointer } { other.m_ReferencePointer = nullptr; }
+	Reference& operator=(const Reference& other)
+	{
+		if (other.m_ReferencePointer) ++other.m_ReferencePointer->m_Counter;
+		if (m_ReferencePointer) --m_ReferencePointer->m_Counter;
+		m_ReferencePointer = other.m_ReferencePointer;
+		return *this;
+	}
+	Reference& operator=(Reference&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_ReferencePointer) --m_ReferencePointer->m_Counter;
+			m_ReferencePointer = other.m_ReferencePointer;
+			other.m_ReferencePointer = nullptr;
+		}
+		return *this;
+	}
+
 	const T* operator->() const { return m_ReferencePointer ? m_ReferencePointer->m_ptr : nullptr; }
 	T* operator->() { return m_ReferencePointer ? m_ReferencePointer->m_ptr : nullptr; }
 	T* get() { return m_ReferencePointer ? m_ReferencePointer->m_ptr : nullptr; }
@@ -106,7 +126,7 @@ public:
 	Reference<T> ToReference() const
 	{
 		auto reference = static_cast<ReferencePointer<T>*>(m_ReferencePointer);
-		return *reference;
+		return Reference<T>(reference);
 	}
 
 	void* Data() { return GetReferencePointer<void>().m_ptr; }
@@ -0,0 +1,161 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "DenseArray.h"
+#include "../Entity/Entity.h"
+
+/**
+ * Paged sparse set mapping entities to a dense position and vice versa.
+ * - The sparse part is split up in pages of PageSize positions indexed by the index of the entityId. Pages are only allocated when an entity inside of them is added.
+ * - The dense part is a contiguous array of entityIds. The position of an entity inside of this array is the position of its data inside of the TypeView.
+ *   The dense part can be kept in a PagedArray using SetMaxSize, so it is never copied when it grows.
+ * Looking up the position of an entity only takes a load of the page and a load of the position.
+ * Because entity indices are recycled by the EntityPool the amount of pages scales with the amount of alive entities and not with the largest id.
+ */
+class SparseSet final
+{
+public:
+
+	using PositionType = uint32_t;
+
+	constexpr static size_t PageSize{ 4096 };
+	constexpr static size_t InvalidPos{ std::numeric_limits<size_t>::max() };
+
+public:
+
+	/** Keeps the dense array in a PagedArray of maxSize entities from now on, the set has to be empty*/
+	void SetMaxSize(size_t maxSize) { m_Dense.SetMaxSize(maxSize); }
+
+	/** Returns true if the entity (including its generation) is inside of the set*/
+	bool contains(entityId id) const { return Find(id) != InvalidPos; }
+
+	/** Returns the position of the entity inside of the dense array or InvalidPos if it is not inside of the set*/
+	size_t Find(entityId id) const
+	{
+		const entityId index{ Entity::GetIndex(id) };
+		const size_t page{ index / PageSize };
+		if (page >= m_Pages.size() || m_Pages[page].empty())
+			return InvalidPos;
+
+		const PositionType pos{ m_Pages[page][index % PageSize] };
+		if (pos == InvalidPosition || m_Dense[pos] != id)
+			return InvalidPos;
+
+		return pos;
+	}
+
+	/** Returns the entity at the position of the dense array*/
+	entityId operator[](size_t pos) const { assert(pos < m_Dense.size()); return m_Dense[pos]; }
+
+	/** Adds the entity at the back of the dense array and returns its position*/
+	size_t push_back(entityId id)
+	{
+		assert(!contains(id));
+		assert(m_Dense.size() < InvalidPosition);
+
+		const size_t pos{ m_Dense.size() };
+		GetOrCreateSparse(id) = PositionType(pos);
+		m_Dense.emplace_back(id);
+		return pos;
+	}
+
+	/** Removes the entity at the back of the dense array*/
+	void pop_back()
+	{
+		assert(!m_Dense.empty());
+		GetSparse(m_Dense.back()) = InvalidPosition;
+		m_Dense.pop_back();
+	}
+
+	/** Swaps the entities on the given positions of the dense array*/
+	void SwapPositions(size_t pos0, size_t pos1)
+	{
+		assert(pos0 < m_Dense.size() && pos1 < m_Dense.size());
+		std::swap(m_Dense[pos0], m_Dense[pos1]);
+		GetSparse(m_Dense[pos0]) = PositionType(pos0);
+		GetSparse(m_Dense[pos1]) = PositionType(pos1);
+	}
+
+	/** Replaces the content of the set by the given entities. Their position will be the position inside of the given array*/
+	void Assign(const entityId* ids, size_t size);
+
+	void reserve(size_t size) { m_Dense.reserve(size); }
+
+	void clear();
+
+	size_t size() const { return m_Dense.size(); }
+	bool empty() const { return m_Dense.empty(); }
+
+	const entityId* data() const { return m_Dense.data(); }
+	std::span<const entityId> GetEntities() const { return { m_Dense.data(), m_Dense.size() }; }
+
+	auto begin() const { return m_Dense.begin(); }
+	auto end() const { return m_Dense.end(); }
+
+	/** Returns the amount of sparse pages that are allocated*/
+	size_t GetPageAmount() const;
+
+private:
+
+	constexpr static PositionType InvalidPosition{ std::numeric_limits<PositionType>::max() };
+
+	PositionType& GetSparse(entityId id)
+	{
+		const entityId index{ Entity::GetIndex(id) };
+		assert(index / PageSize < m_Pages.size() && !m_Pages[index / PageSize].empty());
+		return m_Pages[index / PageSize][index % PageSize];
+	}
+
+	PositionType& GetOrCreateSparse(entityId id)
+	{
+		const entityId index{ Entity::GetIndex(id) };
+		const size_t page{ index / PageSize };
+
+		if (page >= m_Pages.size())
+			m_Pages.resize(page + 1);
+
+		if (m_Pages[page].empty())
+			m_Pages[page].resize(PageSize, InvalidPosition);
+
+		return m_Pages[page][index % PageSize];
+	}
+
+private:
+
+	std::vector<std::vector<PositionType>> m_Pages;
+	DenseArray<entityId> m_Dense;
+
+};
+
+inline void SparseSet::Assign(const entityId* ids, size_t size)
+{
+	for (entityId id : m_Dense)
+		GetSparse(id) = InvalidPosition;
+
+	m_Dense.assign(ids, ids + size);
+
+	for (size_t i{}; i < size; ++i)
+		GetOrCreateSparse(m_Dense[i]) = PositionType(i);
+}
+
+inline void SparseSet::clear()
+{
+	for (entityId id : m_Dense)
+		GetSparse(id) = InvalidPosition;
+
+	m_Dense.clear();
+}
+
+inline size_t SparseSet::GetPageAmount() const
+{
+	size_t amount{};
+	for (auto& page : m_Pages)
+		if (!page.empty())
+			++amount;
+	return amount;
+}
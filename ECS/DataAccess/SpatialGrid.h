@@ -0,0 +1,314 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../Entity/Entity.h"
+
+/**
+ * Uniform grid of 2D points that answers range and nearest neighbour queries by only visiting the cells around the query.
+ * The grid is hashed, so the world has no bounds and the memory only depends on the amount of points.
+ * Building is a counting sort of the points by their cell, afterwards the points of a cell are contiguous in memory.
+ * Points of different cells may share a bucket of the hash table, the queries skip the points of the other cells.
+ * The cell size should be around the size of a typical query, smaller cells visit more empty buckets and larger cells test more points.
+ */
+class SpatialGrid final
+{
+public:
+
+	struct Element
+	{
+		float x;
+		float y;
+		entityId id;
+	};
+
+public:
+
+	explicit SpatialGrid(float cellSize) : m_CellSize(cellSize), m_InverseCellSize(1.f / cellSize) { assert(cellSize > 0.f); }
+
+public:
+
+	/**
+	 * Replaces the points of the grid.
+	 * @param getElement: returns the Element at position i for every i in [0, size)
+	 */
+	template <typename Function>
+	void Build(size_t size, Function&& getElement);
+
+	void clear();
+
+	/** Calls function(const Element&) on every point inside of the rectangle, including its borders*/
+	template <typename Function>
+	void ForEachInRect(float minX, float minY, float maxX, float maxY, Function&& function) const;
+
+	/** Calls function(const Element&) on every point inside of the circle, including its border*/
+	template <typename Function>
+	void ForEachInRadius(float x, float y, float radius, Function&& function) const;
+
+	/** Appends the entities inside of the rectangle to the result*/
+	void QueryRect(float minX, float minY, float maxX, float maxY, std::vector<entityId>& result) const;
+
+	/** Appends the entities inside of the circle to the result*/
+	void QueryRadius(float x, float y, float radius, std::vector<entityId>& result) const;
+
+	/** Appends the amount entities closest to the position to the result, ordered from the closest to the furthest*/
+	void QueryNearest(float x, float y, size_t amount, std::vector<entityId>& result) const;
+
+	size_t size() const { return m_Elements.size(); }
+	bool empty() const { return m_Elements.empty(); }
+
+	float GetCellSize() const { return m_CellSize; }
+
+	/** The points ordered by bucket, the points of a cell are next to each other*/
+	const std::vector<Element>& GetElements() const { return m_Elements; }
+
+private:
+
+	int32_t GetCell(float position) const { return int32_t(std::floor(position * m_InverseCellSize)); }
+
+	size_t GetBucket(int32_t cellX, int32_t cellY) const
+	{
+		const uint64_t hash{ uint64_t(uint32_t(cellX)) * 73856093u ^ uint64_t(uint32_t(cellY)) * 19349663u };
+		return size_t(hash) & m_BucketMask;
+	}
+
+	/** Calls function(const Element&) on the points of the cell*/
+	template <typename Function>
+	void ForEachInCell(int32_t cellX, int32_t cellY, Function& function) const;
+
+	/** Sorts the points of m_Unsorted into the buckets*/
+	void Sort();
+
+private:
+
+	float m_CellSize;
+	float m_InverseCellSize;
+
+	std::vector<Element> m_Elements;
+
+	/** The points of bucket i are at the positions [m_BucketStart[i], m_BucketStart[i + 1])*/
+	std::vector<size_t> m_BucketStart;
+	size_t m_BucketMask{};
+
+	/** The range of cells that contain points*/
+	int32_t m_MinCellX{}, m_MinCellY{}, m_MaxCellX{ -1 }, m_MaxCellY{ -1 };
+
+	/** Kept between builds so rebuilding does not allocate*/
+	std::vector<Element> m_Unsorted;
+	std::vector<size_t> m_Buckets;
+};
+
+template <typename Function>
+void SpatialGrid::Build(size_t size, Function&& getElement)
+{
+	m_Unsorted.resize(size);
+	for (size_t i{}; i < size; ++i)
+		m_Unsorted[i] = getElement(i);
+
+	Sort();
+}
+
+inline void SpatialGrid::clear()
+{
+	m_Elements.clear();
+	m_BucketStart.clear();
+	m_BucketMask = 0;
+	m_MinCellX = m_MinCellY = 0;
+	m_MaxCellX = m_MaxCellY = -1;
+}
+
+inline void SpatialGrid::Sort()
+{
+	const size_t size{ m_Unsorted.size() };
+
+	// At least twice as many buckets as points keeps the amount of points of other cells in a bucket low
+	const size_t bucketAmount{ std::bit_ceil(std::max(size * 2, size_t{ 1 })) };
+	m_BucketMask = bucketAmount - 1;
+	m_BucketStart.assign(bucketAmount + 1, 0);
+	m_Buckets.resize(size);
+
+	m_MinCellX = m_MinCellY = std::numeric_limits<int32_t>::max();
+	m_MaxCellX = m_MaxCellY = std::numeric_limits<int32_t>::min();
+
+	for (size_t i{}; i < size; ++i)
+	{
+		const int32_t cellX{ GetCell(m_Unsorted[i].x) };
+		const int32_t cellY{ GetCell(m_Unsorted[i].y) };
+		m_MinCellX = std::min(m_MinCellX, cellX);
+		m_MinCellY = std::min(m_MinCellY, cellY);
+		m_MaxCellX = std::max(m_MaxCellX, cellX);
+		m_MaxCellY = std::max(m_MaxCellY, cellY);
+
+		m_Buckets[i] = GetBucket(cellX, cellY);
+		++m_BucketStart[m_Buckets[i] + 1];
+	}
+
+	for (size_t i{ 1 }; i <= bucketAmount; ++i)
+		m_BucketStart[i] += m_BucketStart[i - 1];
+
+	// Place every point at the next free position of its bucket, m_BucketStart[i] is moved to the end of bucket i
+	m_Elements.resize(size);
+	for (size_t i{}; i < size; ++i)
+		m_Elements[m_BucketStart[m_Buckets[i]]++] = m_Unsorted[i];
+
+	// Move the starts back to the start of the buckets
+	for (size_t i{ bucketAmount }; i > 0; --i)
+		m_BucketStart[i] = m_BucketStart[i - 1];
+	m_BucketStart[0] = 0;
+
+	if (size == 0)
+		clear();
+}
+
+template <typename Function>
+void SpatialGrid::ForEachInCell(int32_t cellX, int32_t cellY, Function& function) const
+{
+	const size_t bucket{ GetBucket(cellX, cellY) };
+	for (size_t i{ m_BucketStart[bucket] }; i < m_BucketStart[bucket + 1]; ++i)
+	{
+		const Element& element{ m_Elements[i] };
+		if (GetCell(element.x) == cellX && GetCell(element.y) == cellY)
+			function(element);
+	}
+}
+
+template <typename Function>
+void SpatialGrid::ForEachInRect(float minX, float minY, float maxX, float maxY, Function&& function) const
+{
+	if (m_Elements.empty())
+		return;
+
+	const int32_t beginX{ std::max(GetCell(minX), m_MinCellX) };
+	const int32_t beginY{ std::max(GetCell(minY), m_MinCellY) };
+	const int32_t endX{ std::min(GetCell(maxX), m_MaxCellX) };
+	const int32_t endY{ std::min(GetCell(maxY), m_MaxCellY) };
+	if (beginX > endX || beginY > endY)
+		return;
+
+	auto testElement = [minX, minY, maxX, maxY, &function](const Element& element)
+	{
+		if (element.x >= minX && element.x <= maxX && element.y >= minY && element.y <= maxY)
+			function(element);
+	};
+
+	// A rectangle covering more cells than there are buckets is faster to test point by point
+	const uint64_t cellAmount{ uint64_t(endX - beginX + 1) * uint64_t(endY - beginY + 1) };
+	if (cellAmount > m_BucketStart.size())
+	{
+		for (const Element& element : m_Elements)
+			testElement(element);
+		return;
+	}
+
+	for (int32_t cellY{ beginY }; cellY <= endY; ++cellY)
+	{
+		for (int32_t cellX{ beginX }; cellX <= endX; ++cellX)
+			ForEachInCell(cellX, cellY, testElement);
+	}
+}
+
+template <typename Function>
+void SpatialGrid::ForEachInRadius(float x, float y, float radius, Function&& function) const
+{
+	const float radiusSquared{ radius * radius };
+	ForEachInRect(x - radius, y - radius, x + radius, y + radius, [x, y, radiusSquared, &function](const Element& element)
+		{
+			const float dx{ element.x - x };
+			const float dy{ element.y - y };
+			if (dx * dx + dy * dy <= radiusSquared)
+				function(element);
+		});
+}
+
+inline void SpatialGrid::QueryRect(float minX, float minY, float maxX, float maxY, std::vector<entityId>& result) const
+{
+	ForEachInRect(minX, minY, maxX, maxY, [&result](const Element& element) { result.emplace_back(element.id); });
+}
+
+inline void SpatialGrid::QueryRadius(float x, float y, float radius, std::vector<entityId>& result) const
+{
+	ForEachInRadius(x, y, radius, [&result](const Element& element) { result.emplace_back(element.id); });
+}
+
+inline void SpatialGrid::QueryNearest(float x, float y, size_t amount, std::vector<entityId>& result) const
+{
+	if (amount == 0 || m_Elements.empty())
+		return;
+
+	// Max heap of the closest points found so far, the furthest of them is at the top
+	using Candidate = std::pair<float, entityId>;
+	std::priority_queue<Candidate> closest;
+
+	auto testElement = [x, y, amount, &closest](const Element& element)
+	{
+		const float dx{ element.x - x };
+		const float dy{ element.y - y };
+		const float distanceSquared{ dx * dx + dy * dy };
+		if (closest.size() < amount)
+			closest.emplace(distanceSquared, element.id);
+		else if (distanceSquared < closest.top().first)
+		{
+			closest.pop();
+			closest.emplace(distanceSquared, element.id);
+		}
+	};
+
+	const int32_t centerX{ GetCell(x) };
+	const int32_t centerY{ GetCell(y) };
+
+	// Visit the cells in rings around the cell of the position.
+	// The points outside of ring r are at least r cells away, so the search stops once the found points are all closer than that
+	for (int32_t ring{};; ++ring)
+	{
+		const bool coversAll{ centerX - ring <= m_MinCellX && centerX + ring >= m_MaxCellX
+			&& centerY - ring <= m_MinCellY && centerY + ring >= m_MaxCellY };
+
+		// When a ring has more cells than there are points, testing all points is faster than continuing the rings
+		if (uint64_t(ring) * 8 > m_Elements.size() && !coversAll)
+		{
+			closest = {};
+			for (const Element& element : m_Elements)
+				testElement(element);
+			break;
+		}
+
+		if (ring == 0)
+			ForEachInCell(centerX, centerY, testElement);
+		else
+		{
+			for (int32_t i{ -ring }; i <= ring; ++i)
+			{
+				ForEachInCell(centerX + i, centerY - ring, testElement);
+				ForEachInCell(centerX + i, centerY + ring, testElement);
+			}
+			for (int32_t i{ -ring + 1 }; i < ring; ++i)
+			{
+				ForEachInCell(centerX - ring, centerY + i, testElement);
+				ForEachInCell(centerX + ring, centerY + i, testElement);
+			}
+		}
+
+		if (coversAll)
+			break;
+
+		const float reached{ float(ring) * m_CellSize };
+		if (closest.size() == amount && closest.top().first <= reached * reached)
+			break;
+	}
+
+	const size_t begin{ result.size() };
+	result.resize(begin + closest.size());
+	for (size_t i{ result.size() }; i > begin; --i)
+	{
+		result[i - 1] = closest.top().second;
+		closest.pop();
+	}
+}
@@ -0,0 +1,84 @@
+#include "ComponentSignatures.h"
+
+#include <algorithm>
+
+void ComponentSignatures::SetTypeAmount(size_t amount)
+{
+	const size_t wordsPerEntity{ std::max<size_t>(1, (amount + WordBits - 1) / WordBits) };
+	if (wordsPerEntity <= m_WordsPerEntity)
+		return;
+
+	// Move every bitset to its new position, starting at the back so no bitset is overwritten before it is moved
+	const size_t entityAmount{ m_Words.size() / m_WordsPerEntity };
+	m_Words.resize(entityAmount * wordsPerEntity);
+	for (size_t entity{ entityAmount }; entity-- > 0;)
+	{
+		for (size_t i{ wordsPerEntity }; i-- > 0;)
+			m_Words[entity * wordsPerEntity + i] = (i < m_WordsPerEntity) ? m_Words[entity * m_WordsPerEntity + i] : 0;
+	}
+
+	m_WordsPerEntity = wordsPerEntity;
+}
+
+void ComponentSignatures::Set(entityId id, size_t typeIndex)
+{
+	const size_t begin{ Entity::GetIndex(id) * m_WordsPerEntity };
+	if (begin >= m_Words.size())
+		m_Words.resize(begin + m_WordsPerEntity);
+
+	m_Words[begin + typeIndex / WordBits] |= uint64_t{ 1 } << (typeIndex % WordBits);
+}
+
+void ComponentSignatures::Reset(entityId id, size_t typeIndex)
+{
+	const size_t begin{ Entity::GetIndex(id) * m_WordsPerEntity };
+	if (begin < m_Words.size())
+		m_Words[begin + typeIndex / WordBits] &= ~(uint64_t{ 1 } << (typeIndex % WordBits));
+}
+
+bool ComponentSignatures::Test(entityId id, size_t typeIndex) const
+{
+	const uint64_t* words{ GetWords(id) };
+	return words && (words[typeIndex / WordBits] & (uint64_t{ 1 } << (typeIndex % WordBits)));
+}
+
+bool ComponentSignatures::ContainsAll(entityId id, const std::vector<uint64_t>& mask) const
+{
+	const uint64_t* words{ GetWords(id) };
+	for (size_t i{}; i < mask.size(); ++i)
+	{
+		const uint64_t word{ (words && i < m_WordsPerEntity) ? words[i] : 0 };
+		if ((word & mask[i]) != mask[i])
+			return false;
+	}
+	return true;
+}
+
+bool ComponentSignatures::ContainsNone(entityId id, const std::vector<uint64_t>& mask) const
+{
+	const uint64_t* words{ GetWords(id) };
+	if (!words)
+		return true;
+
+	const size_t size{ std::min(mask.size(), m_WordsPerEntity) };
+	for (size_t i{}; i < size; ++i)
+	{
+		if (words[i] & mask[i])
+			return false;
+	}
+	return true;
+}
+
+void ComponentSignatures::SetMaskBit(std::vector<uint64_t>& mask, size_t typeIndex)
+{
+	if (mask.size() <= typeIndex / WordBits)
+		mask.resize(typeIndex / WordBits + 1);
+
+	mask[typeIndex / WordBits] |= uint64_t{ 1 } << (typeIndex % WordBits);
+}
+
+const uint64_t* ComponentSignatures::GetWords(entityId id) const
+{
+	const size_t begin{ Entity::GetIndex(id) * m_WordsPerEntity };
+	return (begin < m_Words.size()) ? m_Words.data() + begin : nullptr;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Entity.h"
+
+/**
+ * Stores for every entity which Components it has as a bitset, where every Component type has a dense index.
+ * The bitsets of all entities are stored in one array, indexed by the index part of the entityId.
+ * The size of the bitsets grows with the amount of types, so any amount of Component types is supported.
+ */
+class ComponentSignatures final
+{
+public:
+
+	static constexpr size_t WordBits{ 64 };
+
+	/** Makes room for the given amount of Component types inside of every bitset*/
+	void SetTypeAmount(size_t amount);
+
+	void Set(entityId id, size_t typeIndex);
+	void Reset(entityId id, size_t typeIndex);
+	bool Test(entityId id, size_t typeIndex) const;
+
+	/** Returns true if the entity has all the types that are set inside of the mask*/
+	bool ContainsAll(entityId id, const std::vector<uint64_t>& mask) const;
+
+	/** Returns true if the entity has none of the types that are set inside of the mask*/
+	bool ContainsNone(entityId id, const std::vector<uint64_t>& mask) const;
+
+	/** Sets the bit of the type index inside of a mask used by ContainsAll() and ContainsNone()*/
+	static void SetMaskBit(std::vector<uint64_t>& mask, size_t typeIndex);
+
+	/**
+	 * Calls the function with the type index of every Component the entity has.
+	 * The function may reset the bits of the entity.
+	 */
+	template <typename Function>
+	void ForEach(entityId id, Function&& function) const;
+
+	/** Removes all the Components of all entities*/
+	void clear() { m_Words.clear(); }
+
+private:
+
+	const uint64_t* GetWords(entityId id) const;
+
+private:
+
+	std::vector<uint64_t> m_Words;
+	size_t m_WordsPerEntity{ 1 };
+
+};
+
+template <typename Function>
+void ComponentSignatures::ForEach(entityId id, Function&& function) const
+{
+	const uint64_t* words{ GetWords(id) };
+	if (!words)
+		return;
+
+	for (size_t i{}; i < m_WordsPerEntity; ++i)
+	{
+		// Copy the word, so the function can modify the bitset while iterating
+		uint64_t word{ words[i] };
+		while (word)
+		{
+			const size_t bit{ static_cast<size_t>(std::countr_zero(word)) };
+			word &= word - 1;
+			function(i * WordBits + bit);
+		}
+	}
+}
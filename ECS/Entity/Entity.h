@@ -1,7 +1,14 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
+/**
+ * An entityId consists of an index and a generation.
+ * The index is stored in the lower bits and gets reused whenever an entity is removed from the registry.
+ * The generation is stored in the upper bits and gets increased every time its index is reused,
+ * so ids of removed entities never match the id of a new entity using the same index.
+ */
 using entityId = size_t;
 
 class EntityRegistry;
@@ -36,5 +43,19 @@ private:
 public:
 
 	constexpr static entityId InvalidId{ std::numeric_limits<entityId>::max() };
+
+	/** Amount of bits of the entityId used for the index. The remaining bits are used for the generation*/
+	constexpr static size_t IndexBits{ (sizeof(entityId) == 8) ? 32 : 20 };
+	constexpr static entityId IndexMask{ (entityId{ 1 } << IndexBits) - 1 };
+	constexpr static entityId GenerationMask{ std::numeric_limits<entityId>::max() >> IndexBits };
+
+	/** Returns the index part of the entityId*/
+	constexpr static entityId GetIndex(entityId id) { return id & IndexMask; }
+
+	/** Returns the generation part of the entityId*/
+	constexpr static entityId GetGeneration(entityId id) { return id >> IndexBits; }
+
+	/** Combines an index and a generation into an entityId*/
+	constexpr static entityId CreateId(entityId index, entityId generation) { return ((generation & GenerationMask) << IndexBits) | (index & IndexMask); }
 };
 
@@ -0,0 +1,130 @@
+#include "EntityPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+entityId EntityPool::Create()
+{
+	entityId index{};
+	if (!m_FreeIndices.empty())
+	{
+		index = m_FreeIndices.back();
+		m_FreeIndices.pop_back();
+	}
+	else
+	{
+		index = m_Slots.size();
+
+		// the last index is reserved so no id can ever be equal to Entity::InvalidId
+		if (index >= Entity::IndexMask)
+			throw std::length_error("Maximum amount of entities reached");
+
+		m_Slots.emplace_back(Entity::CreateId(index, 0), InvalidPos);
+	}
+
+	Slot& slot{ m_Slots[index] };
+	slot.densePos = m_Entities.size();
+	m_Entities.emplace_back(slot.id);
+	NextVersion();
+
+	return slot.id;
+}
+
+void EntityPool::Create(size_t amount, entityId* pIds)
+{
+	if (m_Entities.size() + amount > m_Entities.capacity())
+		m_Entities.reserve(std::max(m_Entities.size() + amount, m_Entities.capacity() * 2));
+
+	// Only the entities that can not reuse a free index need a new slot
+	const size_t newSlots{ (amount > m_FreeIndices.size()) ? amount - m_FreeIndices.size() : 0 };
+	if (m_Slots.size() + newSlots > m_Slots.capacity())
+		m_Slots.reserve(std::max(m_Slots.size() + newSlots, m_Slots.capacity() * 2));
+
+	for (size_t i{}; i < amount; ++i)
+		pIds[i] = Create();
+}
+
+bool EntityPool::Insert(entityId id)
+{
+	assert(id != Entity::InvalidId);
+
+	const entityId index{ Entity::GetIndex(id) };
+	if (index >= Entity::IndexMask)
+		return false;
+
+	if (index >= m_Slots.size())
+	{
+		// The indices that are skipped become available for newly created entities
+		for (entityId i{ m_Slots.size() }; i < index; ++i)
+		{
+			m_Slots.emplace_back(Entity::CreateId(i, 0), InvalidPos);
+			m_FreeIndices.emplace_back(i);
+		}
+		m_Slots.emplace_back(id, InvalidPos);
+	}
+	else
+	{
+		Slot& slot{ m_Slots[index] };
+		if (slot.densePos != InvalidPos)
+			return false;
+
+		auto it = std::find(m_FreeIndices.begin(), m_FreeIndices.end(), index);
+		assert(it != m_FreeIndices.end());
+		*it = m_FreeIndices.back();
+		m_FreeIndices.pop_back();
+
+		slot.id = id;
+	}
+
+	m_Slots[index].densePos = m_Entities.size();
+	m_Entities.emplace_back(id);
+	NextVersion();
+
+	return true;
+}
+
+bool EntityPool::Remove(entityId id)
+{
+	if (!contains(id))
+		return false;
+
+	const entityId index{ Entity::GetIndex(id) };
+	Slot& slot{ m_Slots[index] };
+
+	// swap remove the id from the dense array
+	const entityId lastId{ m_Entities.back() };
+	m_Entities[slot.densePos] = lastId;
+	m_Slots[Entity::GetIndex(lastId)].densePos = slot.densePos;
+	m_Entities.pop_back();
+
+	// increase the generation so old ids will no longer match
+	slot.id = Entity::CreateId(index, Entity::GetGeneration(id) + 1);
+	slot.densePos = InvalidPos;
+
+	m_FreeIndices.emplace_back(index);
+	NextVersion();
+
+	return true;
+}
+
+entityId EntityPool::GetIdFromIndex(entityId index) const
+{
+	if (index < m_Slots.size() && m_Slots[index].densePos != InvalidPos)
+		return m_Slots[index].id;
+	return Entity::InvalidId;
+}
+
+void EntityPool::reserve(size_t size)
+{
+	m_Slots.reserve(size);
+	m_Entities.reserve(size);
+}
+
+void EntityPool::clear()
+{
+	m_Slots.clear();
+	m_Entities.clear();
+	m_FreeIndices.clear();
+	NextVersion();
+}
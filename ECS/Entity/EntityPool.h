@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Entity.h"
+
+/**
+ * Container that hands out and keeps track of the entityIds that are alive inside of a registry.
+ * Indices of removed entities are put in a free list and reused by newly created entities with an increased generation.
+ * Checking whether an entity is alive is done with a single array lookup instead of a hash lookup.
+ * The alive entities are also kept in a contiguous array so they can be iterated over quickly.
+ */
+class EntityPool final
+{
+public:
+
+	using iterator = std::vector<entityId>::const_iterator;
+
+public:
+
+	/** Creates a new entity, reusing the index of a removed entity when one is available*/
+	entityId Create();
+
+	/** Creates amount entities and writes their ids to pIds, the arrays of the pool grow at most once*/
+	void Create(size_t amount, entityId* pIds);
+
+	/**
+	 * Inserts a specific entityId into the pool (used when deserializing or creating entities with a given id).
+	 * Returns false if the index of the id is already used by an alive entity.
+	 */
+	bool Insert(entityId id);
+
+	/** Removes the entity and increases the generation of its index. Returns false if the entity was not alive*/
+	bool Remove(entityId id);
+
+	/** Returns true if the entity is alive inside of the pool*/
+	bool contains(entityId id) const
+	{
+		const entityId index{ Entity::GetIndex(id) };
+		return index < m_Slots.size() && m_Slots[index].id == id && m_Slots[index].densePos != InvalidPos;
+	}
+
+	/** Returns the alive entity that uses the given index or Entity::InvalidId if the index is not in use*/
+	entityId GetIdFromIndex(entityId index) const;
+
+	/** Amount of alive entities*/
+	size_t size() const { return m_Entities.size(); }
+	bool empty() const { return m_Entities.empty(); }
+
+	/** Returns the contiguous array of alive entities. The order changes whenever entities get removed*/
+	const std::vector<entityId>& GetEntities() const { return m_Entities; }
+
+	iterator begin() const { return m_Entities.begin(); }
+	iterator end() const { return m_Entities.end(); }
+
+	/** Reserves memory for the given amount of entities*/
+	void reserve(size_t size);
+
+	/** Removes all the entities and resets all generations*/
+	void clear();
+
+	/**
+	 * Changes whenever an entity is created or removed, used to skip copying the pool into snapshots when it did not change.
+	 * Versions are unique across all pools, so two pools with the same version contain the same entities.
+	 */
+	uint64_t GetVersion() const { return m_Version; }
+
+private:
+
+	void NextVersion() { m_Version = s_Versions.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+private:
+
+	static constexpr size_t InvalidPos{ std::numeric_limits<size_t>::max() };
+
+	/**
+	 * Slot of an index.
+	 * - id: the current id using the index, or the id the next entity using the index will get when it is free
+	 * - densePos: the position of the id inside the m_Entities array, InvalidPos if the index is free
+	 */
+	struct Slot
+	{
+		entityId id;
+		size_t densePos;
+	};
+
+	std::vector<Slot> m_Slots;
+	std::vector<entityId> m_Entities;
+	std::vector<entityId> m_FreeIndices;
+
+	uint64_t m_Version{};
+	inline static std::atomic<uint64_t> s_Versions{};
+
+};
@@ -0,0 +1,275 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	/** The job system and queue index of the worker running on the thread*/
+	thread_local const JobSystem* t_pWorkerJobSystem{};
+	thread_local size_t t_WorkerIndex{};
+}
+
+JobSystem::JobSystem(size_t threadAmount)
+{
+	m_Queues.reserve(threadAmount + 1);
+	for (size_t i{}; i < threadAmount + 1; ++i)
+		m_Queues.emplace_back(std::make_unique<WorkerQueue>());
+
+	m_Workers.reserve(threadAmount);
+	for (size_t i{}; i < threadAmount; ++i)
+		m_Workers.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock{ m_SleepMutex };
+		m_Quit = true;
+	}
+	m_WakeUp.notify_all();
+	m_Workers.clear();
+}
+
+JobSystem& JobSystem::GetInstance()
+{
+	static JobSystem jobSystem{};
+	return jobSystem;
+}
+
+size_t JobSystem::DefaultThreadAmount()
+{
+	return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> function)
+{
+	return Schedule(std::move(function), nullptr, 0);
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> function, std::initializer_list<JobHandle> dependencies)
+{
+	return Schedule(std::move(function), dependencies.begin(), dependencies.size());
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> function, const std::vector<JobHandle>& dependencies)
+{
+	return Schedule(std::move(function), dependencies.data(), dependencies.size());
+}
+
+JobHandle JobSystem::Schedule(std::function<void()>&& function, const JobHandle* dependencies, size_t dependencyAmount)
+{
+	auto job = std::make_shared<Job>(std::move(function));
+
+	for (size_t i{}; i < dependencyAmount; ++i)
+	{
+		Job* dependency{ dependencies[i].m_pJob.get() };
+		if (!dependency)
+			continue;
+
+		std::lock_guard lock{ dependency->m_Mutex };
+		if (!dependency->m_Finished)
+		{
+			dependency->m_Dependents.emplace_back(job);
+			++job->m_UnfinishedDependencies;
+		}
+	}
+
+	JobHandle handle{ job };
+
+	// Remove the scheduling guard, the job is queued here if all dependencies are done already
+	if (--job->m_UnfinishedDependencies == 0)
+		Enqueue(std::move(job));
+
+	return handle;
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+	Job* job{ handle.m_pJob.get() };
+	if (!job)
+		return;
+
+	while (!job->IsDone())
+	{
+		if (auto other = TakeJob())
+		{
+			Execute(other);
+			continue;
+		}
+
+		// No jobs left to help with, the job is being executed by a different thread
+		job->m_Done.wait(false, std::memory_order_acquire);
+	}
+
+	if (job->m_Exception)
+		std::rethrow_exception(job->m_Exception);
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t begin, size_t end)>& function)
+{
+	if (begin >= end)
+		return;
+
+	const size_t size{ end - begin };
+	grainSize = std::max<size_t>(grainSize, 1);
+
+	// Create a few more parts than threads so the workers can balance uneven parts
+	const size_t maxParts{ (GetThreadAmount() + 1) * 4 };
+	const size_t partAmount{ std::min((size + grainSize - 1) / grainSize, maxParts) };
+
+	if (partAmount <= 1)
+	{
+		function(begin, end);
+		return;
+	}
+
+	const size_t partSize{ size / partAmount };
+	const size_t remainder{ size % partAmount };
+
+	std::vector<JobHandle> parts;
+	parts.reserve(partAmount - 1);
+
+	// The first part is executed on the calling thread
+	size_t partBegin{ begin + partSize + (remainder > 0 ? 1 : 0) };
+	for (size_t i{ 1 }; i < partAmount; ++i)
+	{
+		const size_t partEnd{ partBegin + partSize + (i < remainder ? 1 : 0) };
+		parts.emplace_back(Schedule([&function, partBegin, partEnd] { function(partBegin, partEnd); }));
+		partBegin = partEnd;
+	}
+	assert(partBegin == end);
+
+	std::exception_ptr exception;
+	try
+	{
+		function(begin, begin + partSize + (remainder > 0 ? 1 : 0));
+	}
+	catch (...)
+	{
+		exception = std::current_exception();
+	}
+
+	// All the parts have to be done before returning, as they reference the function
+	for (auto& part : parts)
+	{
+		try
+		{
+			Wait(part);
+		}
+		catch (...)
+		{
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+void JobSystem::Enqueue(std::shared_ptr<Job>&& job)
+{
+	const size_t queueIndex{ t_pWorkerJobSystem == this ? t_WorkerIndex : m_Queues.size() - 1 };
+
+	++m_QueuedJobs;
+	{
+		auto& queue{ *m_Queues[queueIndex] };
+		std::lock_guard lock{ queue.mutex };
+		queue.jobs.emplace_back(std::move(job));
+	}
+
+	if (m_SleepingWorkers > 0)
+	{
+		std::lock_guard lock{ m_SleepMutex };
+		m_WakeUp.notify_one();
+	}
+}
+
+std::shared_ptr<Job> JobSystem::TakeJob()
+{
+	if (m_QueuedJobs == 0)
+		return nullptr;
+
+	const size_t ownIndex{ t_pWorkerJobSystem == this ? t_WorkerIndex : m_Queues.size() - 1 };
+
+	// Newest job of the own queue
+	{
+		auto& queue{ *m_Queues[ownIndex] };
+		std::lock_guard lock{ queue.mutex };
+		if (!queue.jobs.empty())
+		{
+			auto job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			--m_QueuedJobs;
+			return job;
+		}
+	}
+
+	// Oldest job of the other queues
+	for (size_t i{ 1 }; i < m_Queues.size(); ++i)
+	{
+		auto& queue{ *m_Queues[(ownIndex + i) % m_Queues.size()] };
+		std::lock_guard lock{ queue.mutex };
+		if (!queue.jobs.empty())
+		{
+			auto job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			--m_QueuedJobs;
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(const std::shared_ptr<Job>& job)
+{
+	try
+	{
+		job->m_Function();
+	}
+	catch (...)
+	{
+		job->m_Exception = std::current_exception();
+	}
+
+	// Release the captures of the function as soon as possible
+	job->m_Function = nullptr;
+
+	std::vector<std::shared_ptr<Job>> dependents;
+	{
+		std::lock_guard lock{ job->m_Mutex };
+		job->m_Finished = true;
+		dependents.swap(job->m_Dependents);
+	}
+
+	job->m_Done.store(true, std::memory_order_release);
+	job->m_Done.notify_all();
+
+	for (auto& dependent : dependents)
+	{
+		if (--dependent->m_UnfinishedDependencies == 0)
+			Enqueue(std::move(dependent));
+	}
+}
+
+void JobSystem::WorkerLoop(size_t workerIndex)
+{
+	t_pWorkerJobSystem = this;
+	t_WorkerIndex = workerIndex;
+
+	while (!m_Quit)
+	{
+		if (auto job = TakeJob())
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock lock{ m_SleepMutex };
+		++m_SleepingWorkers;
+		m_WakeUp.wait(lock, [this] { return m_Quit || m_QueuedJobs > 0; });
+		--m_SleepingWorkers;
+	}
+}
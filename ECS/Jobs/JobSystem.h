@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * A unit of work that is executed by a JobSystem.
+ * A Job is only queued when all the jobs it depends on are done.
+ */
+class Job final
+{
+	friend class JobSystem;
+
+public:
+
+	Job(std::function<void()>&& function) : m_Function(std::move(function)) {}
+
+	Job(const Job&) = delete;
+	Job(Job&&) = delete;
+	Job& operator=(const Job&) = delete;
+	Job& operator=(Job&&) = delete;
+
+	bool IsDone() const { return m_Done.load(std::memory_order_acquire); }
+
+private:
+
+	std::function<void()> m_Function;
+
+	/** Amount of dependencies that are not done yet, plus one while the job is being scheduled*/
+	std::atomic<size_t> m_UnfinishedDependencies{ 1 };
+	std::atomic<bool> m_Done{};
+
+	/** Guards the dependents and the finished state*/
+	std::mutex m_Mutex;
+	std::vector<std::shared_ptr<Job>> m_Dependents;
+	bool m_Finished{};
+
+	std::exception_ptr m_Exception;
+};
+
+/** Handle to a scheduled Job that can be waited on or used as a dependency of other jobs*/
+class JobHandle final
+{
+	friend class JobSystem;
+
+public:
+
+	JobHandle() = default;
+
+	bool IsValid() const { return m_pJob != nullptr; }
+	bool IsDone() const { return !m_pJob || m_pJob->IsDone(); }
+
+private:
+
+	JobHandle(std::shared_ptr<Job> job) : m_pJob(std::move(job)) {}
+
+	std::shared_ptr<Job> m_pJob;
+};
+
+/**
+ * Work stealing job system.
+ * Every worker thread has its own deque of jobs. Workers execute the jobs from the back of their own deque and steal from the front
+ * of the deques of other workers when they run out of jobs. Workers sleep while there are no jobs and are woken up when a job gets queued.
+ * Threads that wait on a job execute other jobs while waiting, so jobs can schedule and wait on jobs themselves.
+ */
+class JobSystem final
+{
+public:
+
+	/** @param threadAmount: amount of worker threads. By default one less than the amount of hardware threads, as the thread that waits also executes jobs*/
+	JobSystem(size_t threadAmount = DefaultThreadAmount());
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem(JobSystem&&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	JobSystem& operator=(JobSystem&&) = delete;
+
+	/** Job system shared by all registries that were not given a different one*/
+	static JobSystem& GetInstance();
+
+	static size_t DefaultThreadAmount();
+
+public:
+
+	/** Queues the function to be executed on one of the workers*/
+	JobHandle Schedule(std::function<void()> function);
+
+	/** Queues the function to be executed once all the dependencies are done*/
+	JobHandle Schedule(std::function<void()> function, std::initializer_list<JobHandle> dependencies);
+	JobHandle Schedule(std::function<void()> function, const std::vector<JobHandle>& dependencies);
+
+	/**
+	 * Executes other jobs until the job is done.
+	 * Rethrows the exception in case the job threw one.
+	 */
+	void Wait(const JobHandle& handle);
+
+	/**
+	 * Splits the range [begin, end) in parts of at least grainSize elements and calls the function with the begin and end of every part concurrently.
+	 * Returns when all the parts are done, the calling thread executes parts as well.
+	 */
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t begin, size_t end)>& function);
+
+	/** Amount of worker threads, without the threads that wait on jobs*/
+	size_t GetThreadAmount() const { return m_Workers.size(); }
+
+private:
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<std::shared_ptr<Job>> jobs;
+	};
+
+	JobHandle Schedule(std::function<void()>&& function, const JobHandle* dependencies, size_t dependencyAmount);
+
+	void Enqueue(std::shared_ptr<Job>&& job);
+
+	/** Takes a job from the queue of the calling worker or steals one from the other queues*/
+	std::shared_ptr<Job> TakeJob();
+
+	void Execute(const std::shared_ptr<Job>& job);
+
+	void WorkerLoop(size_t workerIndex);
+
+private:
+
+	/** One queue per worker, the last queue is used by threads that are not workers*/
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+	std::vector<std::jthread> m_Workers;
+
+	std::atomic<size_t> m_QueuedJobs{};
+	std::atomic<size_t> m_SleepingWorkers{};
+
+	std::mutex m_SleepMutex;
+	std::condition_variable m_WakeUp;
+
+	std::atomic<bool> m_Quit{};
+};
@@ -0,0 +1,140 @@
+#include "Archetype.h"
+
+#include <algorithm>
+
+namespace
+{
+	size_t AlignOffset(size_t offset, size_t alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+}
+
+Archetype::Archetype(std::vector<ArchetypeComponentInfo> components)
+{
+	assert(std::is_sorted(components.begin(), components.end(),
+		[](const ArchetypeComponentInfo& c0, const ArchetypeComponentInfo& c1) { return c0.typeId < c1.typeId; }));
+
+	m_Columns.reserve(components.size());
+	m_TypeIds.reserve(components.size());
+	for (auto& component : components)
+	{
+		assert(component.alignment <= ArchetypeChunk::Alignment);
+		m_Columns.emplace_back(Column{ component, 0, 0 });
+		m_TypeIds.emplace_back(component.typeId);
+	}
+
+	// Calculate how many rows fit inside of a chunk
+	size_t rowSize{ sizeof(entityId) };
+	for (auto& column : m_Columns)
+		rowSize += column.info.size + sizeof(ReferencePointer<void>*);
+
+	m_ChunkCapacity = std::max<size_t>(ChunkByteSize / rowSize, 1);
+
+	// Lay out the columns, lowering the capacity in case the alignment padding does not fit
+	while (true)
+	{
+		size_t offset{ m_ChunkCapacity * sizeof(entityId) };
+		for (auto& column : m_Columns)
+		{
+			offset = AlignOffset(offset, column.info.alignment);
+			column.offset = offset;
+			offset += m_ChunkCapacity * column.info.size;
+		}
+		for (auto& column : m_Columns)
+		{
+			offset = AlignOffset(offset, alignof(ReferencePointer<void>*));
+			column.referenceOffset = offset;
+			offset += m_ChunkCapacity * sizeof(ReferencePointer<void>*);
+		}
+
+		if (offset <= ChunkByteSize || m_ChunkCapacity == 1)
+		{
+			m_ChunkByteSize = std::max(offset, ChunkByteSize);
+			break;
+		}
+		--m_ChunkCapacity;
+	}
+}
+
+Archetype::~Archetype()
+{
+	for (size_t row{}; row < m_Size; ++row)
+		for (size_t column{}; column < m_Columns.size(); ++column)
+			m_Columns[column].info.destroy(GetComponent(column, row));
+}
+
+size_t Archetype::GetColumn(uint32_t typeId) const
+{
+	auto it = std::lower_bound(m_TypeIds.begin(), m_TypeIds.end(), typeId);
+	if (it != m_TypeIds.end() && *it == typeId)
+		return it - m_TypeIds.begin();
+	return InvalidColumn;
+}
+
+entityId Archetype::GetEntity(size_t row) const
+{
+	return *reinterpret_cast<const entityId*>(GetAddress(row, 0, sizeof(entityId)));
+}
+
+void* Archetype::GetComponent(size_t column, size_t row) const
+{
+	const Column& col{ m_Columns[column] };
+	return GetAddress(row, col.offset, col.info.size);
+}
+
+ReferencePointer<void>*& Archetype::GetReference(size_t column, size_t row) const
+{
+	return *reinterpret_cast<ReferencePointer<void>**>(GetAddress(row, m_Columns[column].referenceOffset, sizeof(ReferencePointer<void>*)));
+}
+
+size_t Archetype::AddRow(entityId id)
+{
+	if (m_Size == m_Chunks.size() * m_ChunkCapacity)
+		m_Chunks.emplace_back(std::make_unique<ArchetypeChunk>(m_ChunkByteSize));
+
+	const size_t row{ m_Size++ };
+	++m_Chunks[row / m_ChunkCapacity]->m_Size;
+
+	*reinterpret_cast<entityId*>(GetAddress(row, 0, sizeof(entityId))) = id;
+	for (size_t column{}; column < m_Columns.size(); ++column)
+		GetReference(column, row) = nullptr;
+
+	return row;
+}
+
+entityId Archetype::RemoveRow(size_t row)
+{
+	assert(row < m_Size);
+
+	const size_t last{ m_Size - 1 };
+	entityId movedEntity{ Entity::InvalidId };
+
+	if (row != last)
+	{
+		movedEntity = GetEntity(last);
+		*reinterpret_cast<entityId*>(GetAddress(row, 0, sizeof(entityId))) = movedEntity;
+
+		for (size_t column{}; column < m_Columns.size(); ++column)
+		{
+			void* source{ GetComponent(column, last) };
+			void* target{ GetComponent(column, row) };
+			m_Columns[column].info.moveConstruct(target, source);
+			m_Columns[column].info.destroy(source);
+
+			auto& reference = GetReference(column, row);
+			reference = GetReference(column, last);
+			if (reference)
+				reference->m_ptr = target;
+		}
+	}
+
+	--m_Chunks[last / m_ChunkCapacity]->m_Size;
+	--m_Size;
+
+	// Keep one empty chunk around so adding and removing at a chunk boundary does not reallocate
+	if (m_Chunks.size() > 1 && m_Chunks[m_Chunks.size() - 2]->m_Size == 0)
+		m_Chunks.pop_back();
+
+	return movedEntity;
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../Entity/Entity.h"
+#include "../DataAccess/References.h"
+#include "../TypeInformation/TypeInformation.h"
+
+class EntityRegistry;
+
+/**
+ * Type erased information about a Component that is needed to store it inside of an Archetype.
+ * Use ArchetypeComponentInfo::Create<Component>() to generate it.
+ */
+struct ArchetypeComponentInfo
+{
+	uint32_t typeId{};
+	size_t size{};
+	size_t alignment{};
+
+	void (*construct)(void* address){};
+	void (*moveConstruct)(void* address, void* source){};
+	void (*destroy)(void* address){};
+
+	/** nullptr if the Component is not Initializable*/
+	void (*initialize)(void* address, EntityRegistry* registry){};
+
+	template <typename Component>
+	static ArchetypeComponentInfo Create();
+};
+
+/**
+ * Fixed size block of memory that stores the rows of an Archetype.
+ * The layout of the chunk is decided by the Archetype, every Component has its own contiguous column (SoA):
+ * [entities][Component 0]...[Component n][references 0]...[references n]
+ */
+class ArchetypeChunk final
+{
+public:
+
+	constexpr static size_t Alignment{ 64 };
+
+public:
+
+	ArchetypeChunk(size_t byteSize)
+		: m_pData{ static_cast<std::byte*>(::operator new(byteSize, std::align_val_t{ Alignment })) }
+	{}
+	~ArchetypeChunk() { ::operator delete(m_pData, std::align_val_t{ Alignment }); }
+
+	ArchetypeChunk(const ArchetypeChunk&) = delete;
+	ArchetypeChunk(ArchetypeChunk&&) = delete;
+	ArchetypeChunk& operator=(const ArchetypeChunk&) = delete;
+	ArchetypeChunk& operator=(ArchetypeChunk&&) = delete;
+
+	std::byte* GetData() const { return m_pData; }
+
+	/** Amount of rows that are used inside of the chunk*/
+	size_t GetSize() const { return m_Size; }
+
+private:
+
+	friend class Archetype;
+
+	std::byte* m_pData{};
+	size_t m_Size{};
+};
+
+/**
+ * An Archetype stores all entities that have the exact same set of Components.
+ * The Components are stored in ArchetypeChunks of (at least) ChunkByteSize bytes. All chunks except the last one are always full,
+ * so the rows can be addressed with a single index and removing a row moves the last row into the gap.
+ * Reference pointers to the Components are only created when a Reference is requested and are updated when their Component moves.
+ */
+class Archetype final
+{
+public:
+
+	constexpr static size_t ChunkByteSize{ 16 * 1024 };
+	constexpr static size_t InvalidColumn{ std::numeric_limits<size_t>::max() };
+
+public:
+
+	/** The components have to be sorted by their typeId*/
+	Archetype(std::vector<ArchetypeComponentInfo> components);
+	~Archetype();
+
+	Archetype(const Archetype&) = delete;
+	Archetype(Archetype&&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+	Archetype& operator=(Archetype&&) = delete;
+
+public:
+
+	/** Returns the sorted typeIds of the Components inside of the Archetype*/
+	const std::vector<uint32_t>& GetTypeIds() const { return m_TypeIds; }
+
+	const ArchetypeComponentInfo& GetComponentInfo(size_t column) const { return m_Columns[column].info; }
+
+	/** Returns the column of the Component or InvalidColumn if the Archetype does not contain it*/
+	size_t GetColumn(uint32_t typeId) const;
+
+	bool Contains(uint32_t typeId) const { return GetColumn(typeId) != InvalidColumn; }
+
+	size_t GetColumnAmount() const { return m_Columns.size(); }
+
+	/** Amount of entities inside of the Archetype*/
+	size_t GetSize() const { return m_Size; }
+
+	/** Amount of rows that fit inside of a single chunk*/
+	size_t GetChunkCapacity() const { return m_ChunkCapacity; }
+
+	size_t GetChunkAmount() const { return m_Chunks.size(); }
+
+	const ArchetypeChunk& GetChunk(size_t chunk) const { return *m_Chunks[chunk]; }
+
+	/** Returns the start of the column of the Component inside of the chunk*/
+	std::byte* GetColumnData(size_t chunk, size_t column) const { return m_Chunks[chunk]->GetData() + m_Columns[column].offset; }
+
+	/** Returns the start of the entity column inside of the chunk*/
+	const entityId* GetEntities(size_t chunk) const { return reinterpret_cast<const entityId*>(m_Chunks[chunk]->GetData()); }
+
+	entityId GetEntity(size_t row) const;
+
+	void* GetComponent(size_t column, size_t row) const;
+
+	ReferencePointer<void>*& GetReference(size_t column, size_t row) const;
+
+	/**
+	 * Adds a row for the entity at the back of the Archetype and returns the row.
+	 * The memory of the Components is left uninitialized and has to be constructed by the caller.
+	 */
+	size_t AddRow(entityId id);
+
+	/**
+	 * Removes the row by moving the last row into it. The Components of the row have to be destroyed or moved out by the caller.
+	 * Returns the entity that was moved into the row or Entity::InvalidId if the last row was removed.
+	 */
+	entityId RemoveRow(size_t row);
+
+	/** Cached transitions to the Archetype that is reached by adding or removing a Component*/
+	std::unordered_map<uint32_t, Archetype*> AddEdges;
+	std::unordered_map<uint32_t, Archetype*> RemoveEdges;
+
+private:
+
+	struct Column
+	{
+		ArchetypeComponentInfo info;
+		size_t offset;
+		size_t referenceOffset;
+	};
+
+	std::byte* GetAddress(size_t row, size_t offset, size_t elementSize) const
+	{
+		assert(row < m_Size);
+		return m_Chunks[row / m_ChunkCapacity]->GetData() + offset + (row % m_ChunkCapacity) * elementSize;
+	}
+
+private:
+
+	std::vector<Column> m_Columns;
+	std::vector<uint32_t> m_TypeIds;
+	std::vector<std::unique_ptr<ArchetypeChunk>> m_Chunks;
+
+	size_t m_ChunkCapacity{};
+	size_t m_ChunkByteSize{};
+	size_t m_Size{};
+};
+
+template <typename Component>
+ArchetypeComponentInfo ArchetypeComponentInfo::Create()
+{
+	ArchetypeComponentInfo info{};
+	info.typeId = reflection::type_id<Component>();
+	info.size = sizeof(Component);
+	info.alignment = alignof(Component);
+	info.construct = [](void* address) { new (address) Component(); };
+	info.moveConstruct = [](void* address, void* source) { new (address) Component(std::move(*static_cast<Component*>(source))); };
+	info.destroy = [](void* address) { static_cast<Component*>(address)->~Component(); };
+
+	if constexpr (Initializable<Component>)
+		info.initialize = [](void* address, EntityRegistry* registry) { static_cast<Component*>(address)->Initialize(registry); };
+
+	return info;
+}
@@ -0,0 +1,383 @@
+#include "ArchetypeStorage.h"
+
+#include <algorithm>
+#include <new>
+
+#include "../TypeInformation/TypeInformation.h"
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	// Invalidate the references before the Components are destroyed together with their Archetype
+	for (auto& archetype : m_Archetypes)
+		for (size_t row{}; row < archetype->GetSize(); ++row)
+			for (size_t column{}; column < archetype->GetColumnAmount(); ++column)
+				if (auto reference = archetype->GetReference(column, row))
+					reference->m_ptr = nullptr;
+}
+
+bool ArchetypeStorage::RegisterComponent(const ArchetypeComponentInfo& info)
+{
+	return m_ComponentInfo.emplace(info.typeId, info).second;
+}
+
+VoidReference ArchetypeStorage::AddComponent(entityId id, uint32_t typeId)
+{
+	assert(id != Entity::InvalidId);
+	assert(IsRegistered(typeId));
+
+	EntityLocation& location{ GetOrCreateLocation(id) };
+	assert(!location.archetype || !location.archetype->Contains(typeId));
+
+	Archetype* target{ GetAddTarget(location.archetype, typeId) };
+	MoveEntity(location, target);
+
+	const size_t column{ target->GetColumn(typeId) };
+	void* address{ target->GetComponent(column, location.row) };
+
+	const ArchetypeComponentInfo& info{ target->GetComponentInfo(column) };
+	info.construct(address);
+
+	auto& reference = target->GetReference(column, location.row);
+	reference = CreateReference(address);
+
+	if (info.initialize)
+		info.initialize(address, m_pRegistry);
+
+	return VoidReference(reference);
+}
+
+void ArchetypeStorage::AddComponent(entityId id, uint32_t typeId, void* component)
+{
+	assert(id != Entity::InvalidId);
+	assert(IsRegistered(typeId));
+
+	EntityLocation& location{ GetOrCreateLocation(id) };
+	if (location.archetype && location.archetype->Contains(typeId))
+		return;
+
+	Archetype* target{ GetAddTarget(location.archetype, typeId) };
+	MoveEntity(location, target);
+
+	const size_t column{ target->GetColumn(typeId) };
+	void* address{ target->GetComponent(column, location.row) };
+
+	const ArchetypeComponentInfo& info{ target->GetComponentInfo(column) };
+	info.moveConstruct(address, component);
+
+	if (info.initialize)
+		info.initialize(address, m_pRegistry);
+}
+
+void ArchetypeStorage::RemoveComponent(entityId id, uint32_t typeId)
+{
+	EntityLocation* location{ GetLocation(id) };
+	if (!location || !location->archetype || !location->archetype->Contains(typeId))
+		return;
+
+	MoveEntity(*location, GetRemoveTarget(location->archetype, typeId));
+}
+
+void ArchetypeStorage::RemoveEntity(entityId id)
+{
+	EntityLocation* location{ GetLocation(id) };
+	if (!location)
+		return;
+
+	MoveEntity(*location, nullptr);
+	location->id = Entity::InvalidId;
+}
+
+bool ArchetypeStorage::Contains(entityId id, uint32_t typeId) const
+{
+	const EntityLocation* location{ GetLocation(id) };
+	return location && location->archetype && location->archetype->Contains(typeId);
+}
+
+void* ArchetypeStorage::GetComponentData(entityId id, uint32_t typeId) const
+{
+	const EntityLocation* location{ GetLocation(id) };
+	if (!location || !location->archetype)
+		return nullptr;
+
+	const size_t column{ location->archetype->GetColumn(typeId) };
+	if (column == Archetype::InvalidColumn)
+		return nullptr;
+
+	return location->archetype->GetComponent(column, location->row);
+}
+
+VoidReference ArchetypeStorage::GetComponent(entityId id, uint32_t typeId)
+{
+	const EntityLocation* location{ GetLocation(id) };
+	if (!location || !location->archetype)
+		return VoidReference(nullptr);
+
+	Archetype* archetype{ location->archetype };
+	const size_t column{ archetype->GetColumn(typeId) };
+	if (column == Archetype::InvalidColumn)
+		return VoidReference(nullptr);
+
+	auto& reference = archetype->GetReference(column, location->row);
+	if (!reference)
+		reference = CreateReference(archetype->GetComponent(column, location->row));
+
+	return VoidReference(reference);
+}
+
+Archetype* ArchetypeStorage::GetArchetype(entityId id) const
+{
+	const EntityLocation* location{ GetLocation(id) };
+	return location ? location->archetype : nullptr;
+}
+
+size_t ArchetypeStorage::GetComponentAmount(uint32_t typeId) const
+{
+	size_t amount{};
+	for (auto& archetype : m_Archetypes)
+		if (archetype->Contains(typeId))
+			amount += archetype->GetSize();
+	return amount;
+}
+
+void ArchetypeStorage::Update(float deltaTime)
+{
+	m_AccumulatedTime += deltaTime;
+
+	if (m_AccumulatedTime >= ReferenceRemovalInterval)
+	{
+		m_AccumulatedTime -= ReferenceRemovalInterval;
+
+		const size_t size = m_PendingDeleteReferences.size();
+		for (size_t i{}; i < size; ++i)
+		{
+			auto ref = m_PendingDeleteReferences[size - i - 1];
+			if (ref->GetReferencesAmount() == 0)
+			{
+				m_ReferencePool.deallocate(ref);
+				m_PendingDeleteReferences[size - i - 1] = m_PendingDeleteReferences.back();
+				m_PendingDeleteReferences.pop_back();
+			}
+		}
+	}
+}
+
+ArchetypeStorage::EntityLocation* ArchetypeStorage::GetLocation(entityId id)
+{
+	const entityId index{ Entity::GetIndex(id) };
+	if (index < m_Locations.size() && m_Locations[index].id == id)
+		return &m_Locations[index];
+	return nullptr;
+}
+
+const ArchetypeStorage::EntityLocation* ArchetypeStorage::GetLocation(entityId id) const
+{
+	const entityId index{ Entity::GetIndex(id) };
+	if (index < m_Locations.size() && m_Locations[index].id == id)
+		return &m_Locations[index];
+	return nullptr;
+}
+
+ArchetypeStorage::EntityLocation& ArchetypeStorage::GetOrCreateLocation(entityId id)
+{
+	const entityId index{ Entity::GetIndex(id) };
+	if (index >= m_Locations.size())
+		m_Locations.resize(index + 1);
+
+	EntityLocation& location{ m_Locations[index] };
+	if (location.id != id)
+	{
+		// The index was used by an older generation of the entity
+		if (location.id != Entity::InvalidId)
+			MoveEntity(location, nullptr);
+
+		location.id = id;
+		location.archetype = nullptr;
+		location.row = 0;
+	}
+	return location;
+}
+
+Archetype* ArchetypeStorage::GetOrCreateArchetype(const std::vector<uint32_t>& typeIds)
+{
+	assert(!typeIds.empty());
+
+	auto it = m_ArchetypeMap.find(typeIds);
+	if (it != m_ArchetypeMap.end())
+		return it->second;
+
+	std::vector<ArchetypeComponentInfo> components;
+	components.reserve(typeIds.size());
+	for (uint32_t typeId : typeIds)
+	{
+		assert(IsRegistered(typeId));
+		components.emplace_back(m_ComponentInfo.find(typeId)->second);
+	}
+
+	Archetype* archetype{ m_Archetypes.emplace_back(std::make_unique<Archetype>(std::move(components))).get() };
+	m_ArchetypeMap.emplace(typeIds, archetype);
+	return archetype;
+}
+
+Archetype* ArchetypeStorage::GetAddTarget(Archetype* source, uint32_t typeId)
+{
+	if (!source)
+		return GetOrCreateArchetype({ typeId });
+
+	auto it = source->AddEdges.find(typeId);
+	if (it != source->AddEdges.end())
+		return it->second;
+
+	std::vector<uint32_t> typeIds{ source->GetTypeIds() };
+	typeIds.insert(std::upper_bound(typeIds.begin(), typeIds.end(), typeId), typeId);
+
+	Archetype* target{ GetOrCreateArchetype(typeIds) };
+	source->AddEdges.emplace(typeId, target);
+	target->RemoveEdges.emplace(typeId, source);
+	return target;
+}
+
+Archetype* ArchetypeStorage::GetRemoveTarget(Archetype* source, uint32_t typeId)
+{
+	assert(source && source->Contains(typeId));
+
+	if (source->GetColumnAmount() == 1)
+		return nullptr;
+
+	auto it = source->RemoveEdges.find(typeId);
+	if (it != source->RemoveEdges.end())
+		return it->second;
+
+	std::vector<uint32_t> typeIds{ source->GetTypeIds() };
+	typeIds.erase(std::find(typeIds.begin(), typeIds.end(), typeId));
+
+	Archetype* target{ GetOrCreateArchetype(typeIds) };
+	source->RemoveEdges.emplace(typeId, target);
+	target->AddEdges.emplace(typeId, source);
+	return target;
+}
+
+void ArchetypeStorage::MoveEntity(EntityLocation& location, Archetype* target)
+{
+	Archetype* source{ location.archetype };
+	const size_t sourceRow{ location.row };
+
+	size_t targetRow{};
+	if (target)
+		targetRow = target->AddRow(location.id);
+
+	if (source)
+	{
+		for (size_t column{}; column < source->GetColumnAmount(); ++column)
+		{
+			const ArchetypeComponentInfo& info{ source->GetComponentInfo(column) };
+			void* sourceAddress{ source->GetComponent(column, sourceRow) };
+			ReferencePointer<void>* reference{ source->GetReference(column, sourceRow) };
+
+			const size_t targetColumn{ target ? target->GetColumn(info.typeId) : Archetype::InvalidColumn };
+			if (targetColumn != Archetype::InvalidColumn)
+			{
+				void* targetAddress{ target->GetComponent(targetColumn, targetRow) };
+				info.moveConstruct(targetAddress, sourceAddress);
+				info.destroy(sourceAddress);
+
+				target->GetReference(targetColumn, targetRow) = reference;
+				if (reference)
+					reference->m_ptr = targetAddress;
+			}
+			else
+			{
+				info.destroy(sourceAddress);
+				ReleaseReference(reference);
+			}
+		}
+
+		RemoveRow(source, sourceRow);
+	}
+
+	location.archetype = target;
+	location.row = targetRow;
+}
+
+void ArchetypeStorage::RemoveRow(Archetype* archetype, size_t row)
+{
+	const entityId movedEntity{ archetype->RemoveRow(row) };
+	if (movedEntity != Entity::InvalidId)
+		m_Locations[Entity::GetIndex(movedEntity)].row = row;
+}
+
+ReferencePointer<void>* ArchetypeStorage::CreateReference(void* address)
+{
+	return new (m_ReferencePool.allocate()) ReferencePointer<void>(address);
+}
+
+void ArchetypeStorage::ReleaseReference(ReferencePointer<void>* reference)
+{
+	if (!reference)
+		return;
+
+	reference->m_ptr = nullptr;
+
+	// deallocate if no references to the element exists
+	if (reference->GetReferencesAmount() == 0)
+		m_ReferencePool.deallocate(reference);
+	else
+		m_PendingDeleteReferences.push_back(reference);
+}
+
+ArchetypeQuery::ArchetypeQuery(const ArchetypeStorage& storage, const uint32_t* typeIds, size_t amount)
+	: m_pStorage{ &storage }
+	, m_TypeIds{ typeIds, typeIds + amount }
+{
+	Refresh();
+}
+
+size_t ArchetypeQuery::GetEntityAmount()
+{
+	Refresh();
+
+	size_t amount{};
+	for (Archetype* archetype : m_Archetypes)
+		amount += archetype->GetSize();
+	return amount;
+}
+
+void ArchetypeQuery::Refresh()
+{
+	auto& archetypes = m_pStorage->GetArchetypes();
+	for (; m_CheckedArchetypes < archetypes.size(); ++m_CheckedArchetypes)
+	{
+		Archetype* archetype{ archetypes[m_CheckedArchetypes].get() };
+
+		std::vector<size_t> columns;
+		columns.reserve(m_TypeIds.size());
+
+		for (uint32_t typeId : m_TypeIds)
+		{
+			size_t column{ archetype->GetColumn(typeId) };
+
+			// Look for a sub class of the type
+			if (column == Archetype::InvalidColumn)
+			{
+				for (size_t i{}; i < archetype->GetColumnAmount(); ++i)
+				{
+					if (TypeInformation::IsSubClass(typeId, archetype->GetTypeIds()[i]))
+					{
+						column = i;
+						break;
+					}
+				}
+			}
+
+			if (column == Archetype::InvalidColumn)
+				break;
+
+			columns.emplace_back(column);
+		}
+
+		if (columns.size() == m_TypeIds.size())
+		{
+			m_Archetypes.emplace_back(archetype);
+			m_Columns.insert(m_Columns.end(), columns.begin(), columns.end());
+		}
+	}
+}
@@ -0,0 +1,205 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Archetype.h"
+#include "../Allocators/ObjectPoolAllocator.h"
+
+/**
+ * Alternative storage for the Components of an EntityRegistry (see StorageMode::Archetypes).
+ * Entities with the same set of Components are grouped into the same Archetype where every Component has its own column inside of fixed size chunks.
+ * Adding or removing a Component moves the entity to a different Archetype.
+ * Systems iterate the storage using an ArchetypeQuery which walks through the chunks of every matching Archetype linearly.
+ */
+class ArchetypeStorage final
+{
+public:
+
+	constexpr static float ReferenceRemovalInterval{ 1 };
+
+public:
+
+	ArchetypeStorage(EntityRegistry* registry) : m_pRegistry(registry) {}
+	~ArchetypeStorage();
+
+	ArchetypeStorage(const ArchetypeStorage&) = delete;
+	ArchetypeStorage(ArchetypeStorage&&) = delete;
+	ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+	ArchetypeStorage& operator=(ArchetypeStorage&&) = delete;
+
+public:
+
+	/** Registers the information needed to store the Component. Returns false if the Component was already registered*/
+	bool RegisterComponent(const ArchetypeComponentInfo& info);
+
+	bool IsRegistered(uint32_t typeId) const { return m_ComponentInfo.contains(typeId); }
+
+	/** Adds a default constructed Component to the entity, which moves the entity to a different Archetype*/
+	VoidReference AddComponent(entityId id, uint32_t typeId);
+
+	/** Adds the Component to the entity by moving the given Component into its Archetype, nothing happens if the entity already has the Component*/
+	void AddComponent(entityId id, uint32_t typeId, void* component);
+
+	/** Removes the Component from the entity, which moves the entity to a different Archetype*/
+	void RemoveComponent(entityId id, uint32_t typeId);
+
+	/** Removes all the Components of the entity*/
+	void RemoveEntity(entityId id);
+
+	bool Contains(entityId id, uint32_t typeId) const;
+
+	/** Returns the address of the Component or nullptr if the entity does not have the Component*/
+	void* GetComponentData(entityId id, uint32_t typeId) const;
+
+	/** Returns a reference to the Component, the reference pointer is created the first time a Component is referenced*/
+	VoidReference GetComponent(entityId id, uint32_t typeId);
+
+	/** Returns the Archetype of the entity or nullptr if the entity has no Components*/
+	Archetype* GetArchetype(entityId id) const;
+
+	const std::vector<std::unique_ptr<Archetype>>& GetArchetypes() const { return m_Archetypes; }
+
+	/** Amount of entities that have the Component*/
+	size_t GetComponentAmount(uint32_t typeId) const;
+
+	/** Frees unused reference pointers*/
+	void Update(float deltaTime);
+
+private:
+
+	struct EntityLocation
+	{
+		entityId id{ Entity::InvalidId };
+		Archetype* archetype{};
+		size_t row{};
+	};
+
+	EntityLocation* GetLocation(entityId id);
+	const EntityLocation* GetLocation(entityId id) const;
+	EntityLocation& GetOrCreateLocation(entityId id);
+
+	/** typeIds have to be sorted*/
+	Archetype* GetOrCreateArchetype(const std::vector<uint32_t>& typeIds);
+	Archetype* GetAddTarget(Archetype* source, uint32_t typeId);
+	Archetype* GetRemoveTarget(Archetype* source, uint32_t typeId);
+
+	/** Moves the entity to the target Archetype. Components that are not inside of the target are destroyed*/
+	void MoveEntity(EntityLocation& location, Archetype* target);
+
+	/** Removes the row and updates the location of the entity that was moved into it*/
+	void RemoveRow(Archetype* archetype, size_t row);
+
+	ReferencePointer<void>* CreateReference(void* address);
+	void ReleaseReference(ReferencePointer<void>* reference);
+
+private:
+
+	EntityRegistry* m_pRegistry{};
+
+	std::unordered_map<uint32_t, ArchetypeComponentInfo> m_ComponentInfo;
+
+	std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+	std::map<std::vector<uint32_t>, Archetype*> m_ArchetypeMap;
+
+	/** Location of every entity indexed by the index of the entityId*/
+	std::vector<EntityLocation> m_Locations;
+
+	ObjectPoolAllocator<ReferencePointer<void>> m_ReferencePool;
+	std::vector<ReferencePointer<void>*> m_PendingDeleteReferences;
+
+	float m_AccumulatedTime{};
+};
+
+/**
+ * Iterates all the entities of an ArchetypeStorage that contain the given Components.
+ * The matching Archetypes are cached and only newly created Archetypes are checked on the next iteration.
+ * A Component matches with a column of the same type or of a sub class of the type.
+ */
+class ArchetypeQuery final
+{
+public:
+
+	ArchetypeQuery(const ArchetypeStorage& storage, const uint32_t* typeIds, size_t amount);
+
+	/** Calls the function with the Components of every entity that matches the query. The Components have to be in the same order as the typeIds*/
+	template <typename... Components, typename Function>
+	void ForEach(Function&& function);
+
+	/** Amount of entities that match the query*/
+	size_t GetEntityAmount();
+
+	const std::vector<uint32_t>& GetTypeIds() const { return m_TypeIds; }
+
+private:
+
+	/** Checks the Archetypes that were created since the last refresh*/
+	void Refresh();
+
+	template <typename... Components, typename Function, size_t... Indices>
+	static void ForEachInChunk(Function& function, const std::array<std::byte*, sizeof...(Components)>& columns,
+		const std::array<size_t, sizeof...(Components)>& strides, size_t size, std::index_sequence<Indices...>);
+
+private:
+
+	const ArchetypeStorage* m_pStorage{};
+	std::vector<uint32_t> m_TypeIds;
+
+	std::vector<Archetype*> m_Archetypes;
+
+	/** The columns of the Components inside of the matched Archetypes, m_TypeIds.size() columns per Archetype*/
+	std::vector<size_t> m_Columns;
+
+	size_t m_CheckedArchetypes{};
+};
+
+template <typename... Components, typename Function>
+void ArchetypeQuery::ForEach(Function&& function)
+{
+	constexpr size_t typesAmount{ sizeof...(Components) };
+	assert(typesAmount == m_TypeIds.size());
+
+	Refresh();
+
+	for (size_t i{}; i < m_Archetypes.size(); ++i)
+	{
+		const Archetype& archetype{ *m_Archetypes[i] };
+		const size_t* columns{ m_Columns.data() + i * typesAmount };
+
+		std::array<size_t, typesAmount> strides;
+		for (size_t j{}; j < typesAmount; ++j)
+			strides[j] = archetype.GetComponentInfo(columns[j]).size;
+
+		for (size_t chunk{}; chunk < archetype.GetChunkAmount(); ++chunk)
+		{
+			std::array<std::byte*, typesAmount> columnData;
+			for (size_t j{}; j < typesAmount; ++j)
+				columnData[j] = archetype.GetColumnData(chunk, columns[j]);
+
+			ForEachInChunk<Components...>(function, columnData, strides, archetype.GetChunk(chunk).GetSize(), std::index_sequence_for<Components...>{});
+		}
+	}
+}
+
+template <typename... Components, typename Function, size_t... Indices>
+void ArchetypeQuery::ForEachInChunk(Function& function, const std::array<std::byte*, sizeof...(Components)>& columns,
+	const std::array<size_t, sizeof...(Components)>& strides, size_t size, std::index_sequence<Indices...>)
+{
+	// Columns of sub classes have a different stride than the Component type
+	if (((strides[Indices] == sizeof(Components)) && ...))
+	{
+		const std::tuple<Components*...> data{ reinterpret_cast<Components*>(columns[Indices])... };
+		for (size_t row{}; row < size; ++row)
+			function(std::get<Indices>(data)[row]...);
+	}
+	else
+	{
+		for (size_t row{}; row < size; ++row)
+			function(*reinterpret_cast<Components*>(columns[Indices] + row * strides[Indices])...);
+	}
+}
@@ -0,0 +1,780 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TypeView.h"
+
+/** Snapshot of a view storing its Components as columns, the columns are copied one after the other*/
+struct ColumnSnapshot final : ViewSnapshot
+{
+	std::vector<std::byte> data;
+};
+
+/**
+ * TypeView of a Component that opted into column storage (see ColumnStorable), every registered member variable is stored in its own array (SoA).
+ * A system that only uses a few member variables of a big Component only loads those from memory,
+ * updating the Depth of a Render Component reads 4 bytes per entity instead of the whole Component.
+ * The bytes of the Component that are not covered by a registered member variable are kept in unnamed columns, so Get() always returns the complete Component.
+ * Every column starts on a cache line and is accessed using GetColumn(&Component::member), whole Components are gathered using Get() and scattered using Set().
+ * The Components have no address and no References, so they can not be used inside of TypeBindings, Queries, SpatialIndices or dynamic systems:
+ * derive from ViewSystem<Component> and access the columns of GetTypeView() inside of Execute() instead.
+ */
+template <typename Component> requires ColumnStorable<Component>
+class TypeView<Component> : public TypeViewBase
+{
+	static_assert(!Sortable<Component>, "Components stored as columns can not be sorted");
+	static_assert(!PreUpdateable<Component> && !Updateable<Component> && !LateUpdateable<Component> && !Renderable<Component> && !LateRenderable<Component>,
+		"Components stored as columns have no default systems, use a ViewSystem accessing the columns instead");
+
+public:
+
+	using ComponentType = Component;
+
+	constexpr static size_t ColumnAlignment{ 64 };
+
+	/** The bytes [offset, offset + size) of every Component, stored contiguously*/
+	struct Column
+	{
+		/** The name of the registered member variable, empty for the bytes between the registered member variables*/
+		std::string name;
+		size_t offset{};
+		size_t size{};
+		std::byte* data{};
+	};
+
+public:
+
+	TypeView(EntityRegistry* pRegistry);
+	~TypeView() override;
+
+	TypeView(const TypeView&) = delete;
+	TypeView(TypeView&&) = delete;
+	TypeView& operator=(const TypeView&) = delete;
+	TypeView& operator=(TypeView&&) = delete;
+
+public:
+
+	void Update(float deltaTime) override;
+
+	/** Components stored as columns have no address*/
+	entityId GetEntityId(const void* elementAddress) override;
+
+	/** Gathers the Component of the entity from the columns*/
+	Component Get(entityId id) const;
+
+	/** Scatters the Component over the columns of the entity and marks it as changed*/
+	void Set(entityId id, const Component& component);
+
+	/** Components stored as columns have no References, the returned reference is invalid*/
+	VoidReference GetVoidReference(entityId) const override { return VoidReference(nullptr); }
+
+	void Add(entityId id, const Component& component);
+	void Add(entityId id) { Add(id, Component{}); }
+	void Add(Entity entity) { Add(entity.GetId()); }
+
+	/** Adds a copy of components[i] to the entity ids[i], the columns grow at most once and are written one after the other*/
+	void Add(std::span<const entityId> ids, std::span<const Component> components);
+
+	Component* AddAfterUpdate(entityId id);
+	Component* AddAfterUpdate(Entity entity) { return AddAfterUpdate(entity.GetId()); }
+
+	void Remove(entityId id) override;
+
+	size_t GetSize() const { return m_EntitySet.size(); }
+	size_t GetActiveAmount() const { return GetSize() - m_InactiveItems; }
+	size_t GetInactiveAmount() const { return m_InactiveItems; }
+
+	/** Returns the columns ordered by their offset inside of the Component*/
+	const std::vector<Column>& GetColumns() const { return m_Columns; }
+
+	/**
+	 * Returns the member variable of the active Components, at the same positions as their entities.
+	 * Writes to the column outside of systems are not detected, use MarkChanged for Changed<> queries and snapshots.
+	 * @throws std::invalid_argument: when the member variable was not registered using RegisterMemberInfo
+	 */
+	template <typename Field>
+	std::span<Field> GetColumn(Field Component::* member);
+
+	template <typename Field>
+	std::span<const Field> GetColumn(Field Component::* member) const;
+
+	/**
+	 * Returns the registered member variable with the given name of the active Components.
+	 * @throws std::invalid_argument: when no member variable of the size of Field was registered with the name
+	 */
+	template <typename Field>
+	std::span<Field> GetColumn(std::string_view name);
+
+	size_t GetElementSize() const override { return sizeof(Component); }
+
+	void SetInactive(entityId id);
+	void SetActive(entityId id);
+	bool IsActive(entityId id) const { return GetPositionInArray(id) < GetActiveAmount(); }
+
+	uint32_t GetTypeId() const override { return typeId; }
+
+	/** The Components are gathered and written in the same layout as the views storing a single array*/
+	void SerializeView(std::ostream& stream) override;
+	void DeserializeView(std::istream& stream) override;
+	void PrintType(std::ostream& stream) override { stream << '[' << reflection::type_name<Component>() << ']'; }
+	TypeViewInfo GetInfo() override;
+	void UpdateInfo(TypeViewInfo& info) override;
+
+	void TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick) override;
+	void RestoreSnapshot(const ViewSnapshot* snapshot) override;
+	void RestoreData(const ViewSnapshot& snapshot) override;
+
+	VoidReference AddEntity(entityId id) override { Add(id); return VoidReference(nullptr); }
+	VoidReference AddEntity(entityId id, void* component) override { Add(id, *static_cast<const Component*>(component)); return VoidReference(nullptr); }
+	void AddEntities(const entityId* ids, size_t amount, const void* component) override;
+	void MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds) override;
+	void* AddAfterUpdate_void(entityId id) override { return AddAfterUpdate(id); }
+
+	/** Components stored as columns have no References, so they can only be enabled and disabled through the entity*/
+	void Enable(const VoidReference& ref) override;
+	void Enable(entityId id) override { SetActive(id); }
+	void Disable(const VoidReference& ref) override;
+	void Disable(entityId id) override { SetInactive(id); }
+	bool IsEnabled(const VoidReference& ref) const override;
+	bool IsEnabled(entityId id) const override { return IsActive(id); }
+
+	/** Components stored as columns have no order*/
+	void SortData() override {}
+
+	size_t GetPositionInArray(entityId id) const
+	{
+		assert(Contains(id));
+		return m_EntitySet.Find(id);
+	}
+
+private:
+
+	VoidIterator GetVoidIterator() override;
+	VoidIterator GetVoidIteratorEnd() override;
+
+	/** The Components are not stored in a single array*/
+	void* GetVoidData() override;
+
+	template <typename Field>
+	const Column& FindColumn(Field Component::* member) const;
+
+	/** Moves the columns into a single new block fitting capacity elements per column*/
+	void Reserve(size_t capacity);
+
+	static size_t GetColumnByteSize(size_t elementSize, size_t capacity) { return (elementSize * capacity + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment; }
+
+	/**
+	 * Adds amount elements to the entities using a single growth of the columns.
+	 * @param store: writes the amount Components to the positions starting at the position it is given
+	 */
+	template <typename Function>
+	void AddBatch(const entityId* ids, size_t amount, Function&& store);
+
+	/**
+	 * Scatters amount Components over the columns starting at position begin, one column at a time.
+	 * @param stride: the distance in bytes between two Components, 0 to store the same Component amount times
+	 */
+	void StoreRange(size_t begin, const std::byte* pComponents, size_t stride, size_t amount);
+
+	void Store(size_t pos, const Component& component) { StoreRange(pos, reinterpret_cast<const std::byte*>(&component), 0, 1); }
+	Component Load(size_t pos) const;
+
+	/** Removes the element at the position while keeping the inactive elements at the back*/
+	void SwapRemove(size_t pos);
+
+	void SwapPositions(size_t pos0, size_t pos1);
+
+	void SwapElements(size_t pos0, size_t pos1) override { SwapPositions(pos0, pos1); }
+
+private:
+
+	std::vector<Column> m_Columns;
+
+	/** The memory of all the columns, every column fits m_Capacity elements*/
+	std::byte* m_pBlock{};
+	size_t m_Capacity{};
+
+	size_t m_InactiveItems{};
+
+	std::vector<std::pair<entityId, Component>> m_AddedEntitiesUpdate;
+
+	const uint32_t typeId{ reflection::type_id<Component>() };
+
+};
+
+template <typename Component> requires ColumnStorable<Component>
+TypeView<Component>::TypeView(EntityRegistry* pRegistry)
+	: TypeViewBase(pRegistry)
+{
+	// The member variables are registered when the class is added to the type information
+	if (!TypeInformation::GetAllTypeInformation().contains(typeId))
+		TypeInformation::AddClass<Component>();
+
+	std::vector<ClassFieldInfo> fields;
+	for (const auto& [name, field] : TypeInformation::GetFieldInfo(typeId))
+		fields.emplace_back(field);
+	std::sort(fields.begin(), fields.end(), [](const ClassFieldInfo& field0, const ClassFieldInfo& field1) { return field0.offset < field1.offset; });
+
+	// The bytes between the registered member variables get their own columns, so every byte of the Component is stored
+	size_t offset{};
+	for (const ClassFieldInfo& field : fields)
+	{
+		if (field.offset < offset || field.offset + field.size > sizeof(Component))
+			throw std::invalid_argument("The registered member variables of " + std::string(reflection::type_name<Component>()) + " overlap");
+
+		if (field.offset > offset)
+			m_Columns.emplace_back(Column{ {}, offset, field.offset - offset });
+
+		m_Columns.emplace_back(Column{ field.name, field.offset, field.size });
+		offset = field.offset + field.size;
+	}
+	if (offset < sizeof(Component))
+		m_Columns.emplace_back(Column{ {}, offset, sizeof(Component) - offset });
+}
+
+template <typename Component> requires ColumnStorable<Component>
+TypeView<Component>::~TypeView()
+{
+	if (m_pBlock)
+		::operator delete(m_pBlock, std::align_val_t{ ColumnAlignment });
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Update(float)
+{
+	for (auto& [id, component] : m_AddedEntitiesUpdate)
+	{
+		Add(id, component);
+	}
+	m_AddedEntitiesUpdate.clear();
+}
+
+template <typename Component> requires ColumnStorable<Component>
+entityId TypeView<Component>::GetEntityId(const void*)
+{
+	throw std::runtime_error("The entity of a Component stored as columns can not be found using its address");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+Component TypeView<Component>::Get(entityId id) const
+{
+	return Load(GetPositionInArray(id));
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Set(entityId id, const Component& component)
+{
+	const size_t pos{ GetPositionInArray(id) };
+	Store(pos, component);
+	m_Ticks.SetChanged(pos, GetCurrentTick());
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Add(entityId id, const Component& component)
+{
+	AddBatch(&id, 1, [this, &component](size_t begin) { Store(begin, component); });
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Add(std::span<const entityId> ids, std::span<const Component> components)
+{
+	assert(ids.size() == components.size());
+	AddBatch(ids.data(), ids.size(), [this, components](size_t begin)
+		{
+			StoreRange(begin, reinterpret_cast<const std::byte*>(components.data()), sizeof(Component), components.size());
+		});
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::AddEntities(const entityId* ids, size_t amount, const void* component)
+{
+	AddBatch(ids, amount, [this, amount, component](size_t begin)
+		{
+			StoreRange(begin, static_cast<const std::byte*>(component), 0, amount);
+		});
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds)
+{
+	assert(target.GetTypeId() == GetTypeId() && &target != this);
+	auto& targetView{ static_cast<TypeView<Component>&>(target) };
+
+	std::vector<size_t> positions(amount);
+	for (size_t i{}; i < amount; ++i)
+		positions[i] = GetPositionInArray(ids[i]);
+
+	// Both views have the same columns, so the Components are copied one column at a time
+	targetView.AddBatch(targetIds, amount, [this, &positions, &targetView](size_t begin)
+		{
+			for (size_t c{}; c < m_Columns.size(); ++c)
+			{
+				const Column& source{ m_Columns[c] };
+				const Column& destination{ targetView.m_Columns[c] };
+				for (size_t i{}; i < positions.size(); ++i)
+					std::memcpy(destination.data + (begin + i) * destination.size, source.data + positions[i] * source.size, source.size);
+			}
+		});
+
+	for (size_t i{}; i < amount; ++i)
+	{
+		if (!IsActive(ids[i]))
+			targetView.SetInactive(targetIds[i]);
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+template <typename Function>
+void TypeView<Component>::AddBatch(const entityId* ids, size_t amount, Function&& store)
+{
+	if (amount == 0)
+		return;
+
+	const size_t begin{ GetSize() };
+	if (begin + amount > m_Capacity)
+		Reserve(std::max({ begin + amount, m_Capacity * 2, size_t{ 4 } }));
+
+	const ChangeTicks::Tick tick{ GetCurrentTick() };
+	++m_Version;
+	for (size_t i{}; i < amount; ++i)
+	{
+		assert(!Contains(ids[i]));
+		m_EntitySet.push_back(ids[i]);
+		m_Ticks.push_back(tick);
+	}
+	store(begin);
+
+	// Keep the inactive elements at the back of the columns, every new element swaps with the first inactive element
+	if (m_InactiveItems)
+	{
+		for (size_t i{}; i < amount; ++i)
+			SwapPositions(begin - m_InactiveItems + i, begin + i);
+	}
+
+	for (auto& callback : OnElementsAdd)
+		callback(this, std::span<const entityId>(ids, amount));
+
+	// The Components are initialized as a copy and scattered again, the callbacks may have moved them
+	if constexpr (Initializable<Component>)
+	{
+		for (size_t i{}; i < amount; ++i)
+		{
+			const size_t pos{ GetPositionInArray(ids[i]) };
+			Component component{ Load(pos) };
+			component.Initialize(GetRegistry());
+			Store(pos, component);
+		}
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+Component* TypeView<Component>::AddAfterUpdate(entityId id)
+{
+	return &m_AddedEntitiesUpdate.emplace_back(id, Component{}).second;
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Remove(entityId id)
+{
+	if (m_EntitySet.contains(id))
+	{
+		for (auto& callback : OnElementRemove)
+			callback(this, id);
+
+		// The owning group may have moved the element inside of the callbacks
+		SwapRemove(m_EntitySet.Find(id));
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+template <typename Field>
+std::span<Field> TypeView<Component>::GetColumn(Field Component::* member)
+{
+	return std::span<Field>(reinterpret_cast<Field*>(FindColumn(member).data), GetActiveAmount());
+}
+
+template <typename Component> requires ColumnStorable<Component>
+template <typename Field>
+std::span<const Field> TypeView<Component>::GetColumn(Field Component::* member) const
+{
+	return std::span<const Field>(reinterpret_cast<const Field*>(FindColumn(member).data), GetActiveAmount());
+}
+
+template <typename Component> requires ColumnStorable<Component>
+template <typename Field>
+std::span<Field> TypeView<Component>::GetColumn(std::string_view name)
+{
+	for (const Column& column : m_Columns)
+	{
+		if (!column.name.empty() && column.name == name && column.size == sizeof(Field))
+			return std::span<Field>(reinterpret_cast<Field*>(column.data), GetActiveAmount());
+	}
+	throw std::invalid_argument(std::string(reflection::type_name<Component>()) + " has no registered member variable " + std::string(name) + " of this size");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+template <typename Field>
+const typename TypeView<Component>::Column& TypeView<Component>::FindColumn(Field Component::* member) const
+{
+	// Member pointers can not be converted to an offset, so the offset is measured on an instance
+	static const Component instance{};
+	const size_t offset{ size_t(reinterpret_cast<const std::byte*>(&(instance.*member)) - reinterpret_cast<const std::byte*>(&instance)) };
+
+	for (const Column& column : m_Columns)
+	{
+		if (!column.name.empty() && column.offset == offset && column.size == sizeof(Field))
+			return column;
+	}
+	throw std::invalid_argument("The member variable at offset " + std::to_string(offset) + " of " + std::string(reflection::type_name<Component>()) + " is not registered");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::SetInactive(entityId id)
+{
+	assert(Contains(id));
+	if (!IsActive(id)) return;
+
+	// The owning group moves the element out of the front before it is swapped to the inactive elements
+	for (auto& callback : OnElementDisable)
+		callback(this, id);
+
+	SwapPositions(GetActiveAmount() - 1, GetPositionInArray(id));
+	++m_InactiveItems;
+	++m_Version;
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::SetActive(entityId id)
+{
+	assert(Contains(id));
+	if (IsActive(id)) return;
+	SwapPositions(GetActiveAmount(), GetPositionInArray(id));
+	--m_InactiveItems;
+	++m_Version;
+
+	for (auto& callback : OnElementEnable)
+		callback(this, id);
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::SerializeView(std::ostream& stream)
+{
+	WriteStream(stream, GetSize());
+	WriteStream(stream, m_InactiveItems);
+	stream.write(reinterpret_cast<const char*>(m_EntitySet.data()), GetSize() * sizeof(entityId));
+
+	const auto sizePos = stream.tellp();
+	WriteStream(stream, size_t{}); // overwritten once the size of the data is known
+	const auto startPos = stream.tellp();
+
+	for (size_t i{}; i < GetSize(); ++i)
+	{
+		Component component{ Load(i) };
+		if constexpr (Streamable<Component>)
+			component.Serialize(stream);
+		else
+			stream.write(reinterpret_cast<const char*>(&component), sizeof(Component));
+	}
+
+	const auto endPos = stream.tellp();
+	stream.seekp(sizePos);
+	WriteStream(stream, size_t(endPos - startPos));
+	stream.seekp(endPos);
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::DeserializeView(std::istream& stream)
+{
+	assert(GetSize() == 0); // Check if view is empty
+
+	size_t size{};
+	ReadStream(stream, size);
+	ReadStream(stream, m_InactiveItems);
+
+	std::vector<entityId> entities(size);
+	stream.read(reinterpret_cast<char*>(entities.data()), size * sizeof(entityId));
+
+	if (size > m_Capacity)
+		Reserve(size);
+	m_EntitySet.Assign(entities.data(), size);
+
+	// The change ticks are not serialized, the deserialized Components count as added and changed now
+	m_Ticks.Assign(size, GetCurrentTick());
+	++m_Version;
+
+	size_t dataSize{};
+	ReadStream(stream, dataSize);
+	const auto beginPos = stream.tellg();
+
+	for (size_t i{}; i < size; ++i)
+	{
+		if constexpr (Streamable<Component>)
+		{
+			Component component{};
+			component.Deserialize(stream);
+			Store(i, component);
+		}
+		else
+		{
+			std::array<std::byte, sizeof(Component)> bytes;
+			stream.read(reinterpret_cast<char*>(bytes.data()), sizeof(Component));
+			StoreRange(i, bytes.data(), 0, 1);
+		}
+	}
+
+	const auto endPos = stream.tellg();
+	if (size_t(endPos - beginPos) != dataSize)
+	{
+		throw std::runtime_error("Deserializing failed for " + std::string(reflection::type_name<Component>()) + ". Amount of data written ("
+			+ std::to_string(dataSize) + ") was different from amount read (" + std::to_string(endPos - beginPos) + ")");
+	}
+
+	for (size_t i{}; i < size; ++i)
+	{
+		for (auto& onAdd : OnElementAdd)
+			onAdd(this, m_EntitySet[i]);
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+TypeViewInfo TypeView<Component>::GetInfo()
+{
+	return TypeViewInfo
+	{
+		GetTypeId(),
+		TypeInformation::GetTypeName(GetTypeId()),
+		GetElementSize(),
+		GetSize(),
+		GetActiveAmount(),
+		GetInactiveAmount()
+	};
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::UpdateInfo(TypeViewInfo& info)
+{
+	info.totalSize = GetSize();
+	info.activeAmount = GetActiveAmount();
+	info.inactiveAmount = GetInactiveAmount();
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick)
+{
+	if (previous && IsUnchangedSince(*previous))
+	{
+		snapshot = previous;
+		return;
+	}
+
+	// A snapshot that is still shared with a newer snapshot may not be overwritten
+	if (!snapshot || snapshot.use_count() > 1)
+		snapshot = std::make_shared<ColumnSnapshot>();
+
+	const size_t size{ GetSize() };
+	auto& data{ static_cast<ColumnSnapshot&>(*snapshot).data };
+	data.resize(size * sizeof(Component));
+
+	std::byte* pData{ data.data() };
+	for (const Column& column : m_Columns)
+	{
+		if (size)
+			std::memcpy(pData, column.data, size * column.size);
+		pData += size * column.size;
+	}
+
+	WriteSnapshot(*snapshot, m_InactiveItems, tick);
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::RestoreSnapshot(const ViewSnapshot* snapshot)
+{
+	const auto* columns{ static_cast<const ColumnSnapshot*>(snapshot) };
+	const size_t size{ snapshot ? snapshot->entities.size() : 0 };
+
+	m_AddedEntitiesUpdate.clear();
+	m_InactiveItems = snapshot ? snapshot->inactiveAmount : 0;
+	m_GroupedAmount = snapshot ? snapshot->groupedAmount : 0;
+	m_DataFlag = snapshot ? snapshot->dataFlag : ViewDataFlag::valid;
+	++m_Version;
+
+	if (HasEntitiesOf(snapshot))
+	{
+		m_Ticks.SetAllChanged(GetCurrentTick());
+	}
+	else
+	{
+		if (size > m_Capacity)
+			Reserve(size);
+		m_EntitySet.Assign(size ? snapshot->entities.data() : nullptr, size);
+		m_Ticks.Assign(size, GetCurrentTick());
+	}
+
+	if (!size)
+		return;
+
+	const std::byte* pData{ columns->data.data() };
+	for (const Column& column : m_Columns)
+	{
+		std::memcpy(column.data, pData, size * column.size);
+		pData += size * column.size;
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::RestoreData(const ViewSnapshot& snapshot)
+{
+	const size_t size{ GetSize() };
+	assert(snapshot.entities.size() == size);
+
+	const std::byte* pData{ static_cast<const ColumnSnapshot&>(snapshot).data.data() };
+	for (const Column& column : m_Columns)
+	{
+		if (size)
+			std::memcpy(column.data, pData, size * column.size);
+		pData += size * column.size;
+	}
+	m_Ticks.SetAllChanged(GetCurrentTick());
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Enable(const VoidReference&)
+{
+	throw std::runtime_error("Components stored as columns have no References and can only be enabled using the entity");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Disable(const VoidReference&)
+{
+	throw std::runtime_error("Components stored as columns have no References and can only be disabled using the entity");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+bool TypeView<Component>::IsEnabled(const VoidReference&) const
+{
+	throw std::runtime_error("Components stored as columns have no References, use IsEnabled(entityId) instead");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+VoidIterator TypeView<Component>::GetVoidIterator()
+{
+	throw std::runtime_error(std::string(reflection::type_name<Component>()) + " is stored as columns and can not be iterated as a single array");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+VoidIterator TypeView<Component>::GetVoidIteratorEnd()
+{
+	throw std::runtime_error(std::string(reflection::type_name<Component>()) + " is stored as columns and can not be iterated as a single array");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void* TypeView<Component>::GetVoidData()
+{
+	throw std::runtime_error(std::string(reflection::type_name<Component>()) + " is stored as columns and can not be used inside of TypeBindings, Queries or SpatialIndices");
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::Reserve(size_t capacity)
+{
+	assert(capacity >= GetSize());
+
+	size_t blockSize{};
+	for (const Column& column : m_Columns)
+		blockSize += GetColumnByteSize(column.size, capacity);
+
+	auto pBlock{ static_cast<std::byte*>(::operator new(blockSize, std::align_val_t{ ColumnAlignment })) };
+
+	std::byte* pColumn{ pBlock };
+	for (Column& column : m_Columns)
+	{
+		if (GetSize())
+			std::memcpy(pColumn, column.data, GetSize() * column.size);
+		column.data = pColumn;
+		pColumn += GetColumnByteSize(column.size, capacity);
+	}
+
+	if (m_pBlock)
+		::operator delete(m_pBlock, std::align_val_t{ ColumnAlignment });
+	m_pBlock = pBlock;
+	m_Capacity = capacity;
+
+	m_EntitySet.reserve(capacity);
+	m_Ticks.reserve(capacity);
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::StoreRange(size_t begin, const std::byte* pComponents, size_t stride, size_t amount)
+{
+	for (const Column& column : m_Columns)
+	{
+		std::byte* pDestination{ column.data + begin * column.size };
+		const std::byte* pSource{ pComponents + column.offset };
+		for (size_t i{}; i < amount; ++i)
+			std::memcpy(pDestination + i * column.size, pSource + i * stride, column.size);
+	}
+}
+
+template <typename Component> requires ColumnStorable<Component>
+Component TypeView<Component>::Load(size_t pos) const
+{
+	std::array<std::byte, sizeof(Component)> bytes;
+	for (const Column& column : m_Columns)
+		std::memcpy(bytes.data() + column.offset, column.data + pos * column.size, column.size);
+	return std::bit_cast<Component>(bytes);
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::SwapRemove(size_t pos)
+{
+	const size_t activeAmount{ GetActiveAmount() };
+	if (pos < activeAmount)
+	{
+		// Move the element to the last active position and then swap it with the last element, so all inactive elements stay at the back
+		SwapPositions(pos, activeAmount - 1);
+		SwapPositions(activeAmount - 1, GetSize() - 1);
+	}
+	else
+	{
+		SwapPositions(pos, GetSize() - 1);
+		--m_InactiveItems;
+	}
+
+	m_EntitySet.pop_back();
+	m_Ticks.pop_back();
+	++m_Version;
+}
+
+template <typename Component> requires ColumnStorable<Component>
+void TypeView<Component>::SwapPositions(size_t pos0, size_t pos1)
+{
+	assert(pos0 < GetSize());
+	assert(pos1 < GetSize());
+	if (pos0 == pos1) return;
+
+	for (const Column& column : m_Columns)
+		std::swap_ranges(column.data + pos0 * column.size, column.data + (pos0 + 1) * column.size, column.data + pos1 * column.size);
+
+	m_EntitySet.SwapPositions(pos0, pos1);
+	m_Ticks.SwapPositions(pos0, pos1);
+	++m_Version;
+
+	for (auto& callback : OnElementMove)
+	{
+		callback(this, m_EntitySet[pos0], pos0);
+		callback(this, m_EntitySet[pos1], pos1);
+	}
+}
@@ -0,0 +1,73 @@
+#include "CommandBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+CommandBuffer::~CommandBuffer()
+{
+	clear();
+
+	for (Block& block : m_Blocks)
+		::operator delete(block.data, std::align_val_t{ BlockAlignment });
+}
+
+void CommandBuffer::RemoveEntity(entityId id)
+{
+	m_Commands.emplace_back(Command{ CommandType::RemoveEntity, 0, id, nullptr, nullptr, NextSequence() });
+}
+
+void CommandBuffer::RemoveComponent(entityId id, uint32_t typeId)
+{
+	m_Commands.emplace_back(Command{ CommandType::RemoveComponent, typeId, id, nullptr, nullptr, NextSequence() });
+}
+
+void* CommandBuffer::AddComponent(entityId id, const ArchetypeComponentInfo& info)
+{
+	void* data{ Allocate(info.size, info.alignment) };
+	info.construct(data);
+
+	m_Commands.emplace_back(Command{ CommandType::AddComponent, info.typeId, id, data, &info, NextSequence() });
+	return data;
+}
+
+void CommandBuffer::Release(size_t amount)
+{
+	assert(amount <= m_Commands.size());
+
+	for (size_t i{}; i < amount; ++i)
+	{
+		if (m_Commands[i].data)
+			m_Commands[i].info->destroy(m_Commands[i].data);
+	}
+	m_Commands.erase(m_Commands.begin(), m_Commands.begin() + amount);
+
+	// The Components of the remaining commands are still inside of the blocks
+	if (m_Commands.empty())
+	{
+		m_CurrentBlock = 0;
+		m_BlockOffset = 0;
+	}
+}
+
+void* CommandBuffer::Allocate(size_t size, size_t alignment)
+{
+	assert(alignment <= BlockAlignment);
+
+	// Use the first block from the current one onwards that still has room for the Component
+	for (; m_CurrentBlock < m_Blocks.size(); ++m_CurrentBlock, m_BlockOffset = 0)
+	{
+		const size_t offset{ (m_BlockOffset + alignment - 1) / alignment * alignment };
+		if (offset + size <= m_Blocks[m_CurrentBlock].size)
+		{
+			m_BlockOffset = offset + size;
+			return m_Blocks[m_CurrentBlock].data + offset;
+		}
+	}
+
+	const size_t blockSize{ std::max(size, BlockSize) };
+	m_Blocks.emplace_back(Block{ static_cast<std::byte*>(::operator new(blockSize, std::align_val_t{ BlockAlignment })), blockSize });
+	m_CurrentBlock = m_Blocks.size() - 1;
+	m_BlockOffset = size;
+	return m_Blocks.back().data;
+}
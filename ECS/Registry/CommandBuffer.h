@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Entity/Entity.h"
+#include "Archetype.h"
+
+/**
+ * Records the structural changes a single thread makes to a registry: removing entities and adding or removing Components.
+ * Every thread records into its own buffer (see EntityRegistry::GetCommandBuffer()), so recording a command does not need any synchronization.
+ * The registry merges the buffers of all threads and plays them back in one sorted pass during its Update.
+ * Every command is numbered by a counter shared by all the buffers of the registry, which keeps the order in which the commands were recorded across threads.
+ *
+ * Added Components are constructed inside of the memory of the buffer and moved into their view or Archetype when the buffer is played back.
+ * The memory of the buffer is kept after playback, so recording only allocates while the buffer grows.
+ */
+class CommandBuffer final
+{
+public:
+
+	enum class CommandType : uint8_t
+	{
+		RemoveEntity,
+		RemoveComponent,
+		AddComponent,
+	};
+
+	struct Command
+	{
+		CommandType type;
+		uint32_t typeId;
+		entityId id;
+
+		/** The constructed Component of an AddComponent command, nullptr for the other commands*/
+		void* data;
+		const ArchetypeComponentInfo* info;
+
+		/** The position of the command in the order all the commands of the registry were recorded in*/
+		uint64_t sequence;
+	};
+
+	/** Size of the blocks the Components are constructed in, bigger Components get a block of their own*/
+	constexpr static size_t BlockSize{ 16384 };
+	constexpr static size_t BlockAlignment{ 64 };
+
+public:
+
+	/** The sequence counter is shared by all the buffers of a registry and has to outlive the buffer*/
+	explicit CommandBuffer(std::atomic<uint64_t>& sequence) : m_pSequence{ &sequence } {}
+	~CommandBuffer();
+
+	CommandBuffer(const CommandBuffer&) = delete;
+	CommandBuffer(CommandBuffer&&) = delete;
+	CommandBuffer& operator=(const CommandBuffer&) = delete;
+	CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+public:
+
+	void RemoveEntity(entityId id);
+
+	void RemoveComponent(entityId id, uint32_t typeId);
+
+	/**
+	 * Default constructs the Component inside of the buffer and returns its address.
+	 * The Component may be modified until the buffer is played back, after which it is moved to the entity.
+	 * The info has to outlive the command.
+	 */
+	void* AddComponent(entityId id, const ArchetypeComponentInfo& info);
+
+	const std::vector<Command>& GetCommands() const { return m_Commands; }
+
+	size_t size() const { return m_Commands.size(); }
+	bool empty() const { return m_Commands.empty(); }
+
+	/**
+	 * Destroys the Components of the first amount commands and removes them from the buffer.
+	 * Commands that were recorded while the buffer was played back are kept for the next playback.
+	 */
+	void Release(size_t amount);
+
+	/** Destroys all the Components and removes all the commands*/
+	void clear() { Release(size()); }
+
+private:
+
+	struct Block
+	{
+		std::byte* data;
+		size_t size;
+	};
+
+	void* Allocate(size_t size, size_t alignment);
+
+	uint64_t NextSequence() { return m_pSequence->fetch_add(1, std::memory_order_relaxed); }
+
+private:
+
+	std::vector<Command> m_Commands;
+	std::atomic<uint64_t>* m_pSequence;
+
+	std::vector<Block> m_Blocks;
+	size_t m_CurrentBlock{};
+	size_t m_BlockOffset{};
+};
@@ -4,17 +4,36 @@
 #include "../TypeInformation/ECSTypeInformation.h"
 #include "../Serialize/Serializer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <limits>
+#include <tuple>
 #include <unordered_map>
 
-EntityRegistry::~EntityRegistry()
+namespace
 {
-	for (size_t i{}; i < m_SortingProgress.size(); ++i)
-	{
-		m_SortingProgress[i] = SortingProgress::canceled;
-	}
-	m_SortingThreadPool.QuitAndWait();
+	/** The command buffers of the calling thread, indexed by the id of their registry*/
+	thread_local std::unordered_map<uint64_t, CommandBuffer*> t_CommandBuffers;
+
+	/** The last command buffer used by the calling thread, so looking it up again is a single comparison*/
+	thread_local uint64_t t_LastRegistryId{ std::numeric_limits<uint64_t>::max() };
+	thread_local CommandBuffer* t_pLastCommandBuffer{};
+}
+
+EntityRegistry::EntityRegistry(StorageMode storageMode)
+{
+	if (storageMode == StorageMode::Archetypes)
+		m_pArchetypeStorage = std::make_unique<ArchetypeStorage>(this);
+}
+
+void EntityRegistry::SetJobSystem(JobSystem& jobSystem)
+{
+	m_pJobSystem = &jobSystem;
+	m_SystemScheduler.SetJobSystem(&jobSystem);
+
+	for (auto& system : m_Systems)
+		system->SetJobSystem(&jobSystem);
 }
 
 void EntityRegistry::AddDefaultSystems(uint32_t typeId)
@@ -32,6 +51,53 @@ bool EntityRegistry::ContainsSystem(const std::string& name) const
 	return false;
 }
 
+SystemBase* EntityRegistry::AddReactiveSystem(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event,
+	const std::function<void(EntityRegistry&, entityId)>& function)
+{
+	return AddReactiveSystem(new ReactiveSystemDynamic{ parameters, typeId, event, function });
+}
+
+SystemBase* EntityRegistry::AddReactiveSystem(ReactiveSystemBase* system)
+{
+	if (m_pArchetypeStorage)
+	{
+		delete system;
+		throw std::runtime_error("Reactive systems can not be added to a registry using StorageMode::Archetypes");
+	}
+
+	system->SetTypeView(GetOrCreateView(system->GetObservedTypeId()));
+	system->SetObserver(AddObserver(system->GetObservedTypeId(), system->GetObservedEvent()));
+	system->Initialize();
+
+	EmplaceSystem(system);
+
+	return system;
+}
+
+ObserverStorage* EntityRegistry::AddObserver(uint32_t typeId, ObserverEvent event)
+{
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Observers can not be added to a registry using StorageMode::Archetypes");
+
+	auto& observer = m_Observers.emplace_back(std::make_unique<ObserverStorage>(typeId, event));
+
+	observer->Observe(GetOrCreateView(typeId));
+	for (uint32_t subClassId : TypeInformation::GetSubClasses(typeId))
+		observer->Observe(GetOrCreateView(subClassId));
+
+	return observer.get();
+}
+
+const SpatialIndexBase* EntityRegistry::GetSpatialIndex(uint32_t typeId) const
+{
+	for (auto& spatialIndex : m_SpatialIndices)
+	{
+		if (spatialIndex->GetTypeId() == typeId)
+			return spatialIndex.get();
+	}
+	return nullptr;
+}
+
 SystemBase* EntityRegistry::AddSystem(const std::string& name)
 {
 	auto& systemAdder = ECSTypeInformation::GetSystemAdders();
@@ -122,6 +188,7 @@ void EntityRegistry::RemoveSystem(std::string name)
 		auto typeIds = it->get()->GetTypeIds();
 
 		m_Systems.erase(it);
+		m_SystemScheduler.Invalidate();
 
 		// Remove subsystems
 		for (uint32_t typeId : typeIds)
@@ -135,6 +202,7 @@ void EntityRegistry::RemoveSystem(std::string name)
 
 TypeViewBase* EntityRegistry::AddView(uint32_t typeId)
 {
+	assert(!m_pArchetypeStorage); // Registries using StorageMode::Archetypes do not have Type Views
 	return ECSTypeInformation::AddTypeView(typeId, this);
 }
 
@@ -152,12 +220,96 @@ TypeViewBase* EntityRegistry::GetOrCreateView(uint32_t typeId)
 		return AddView(typeId);
 }
 
+void EntityRegistry::MarkChanged(uint32_t typeId, entityId id)
+{
+	GetTypeView(typeId)->MarkChanged(id);
+}
+
 Entity EntityRegistry::CreateEntity()
 {
-	entityId newId = m_EntityCounter++;
-	assert(!m_Entities.contains(newId));
-	m_Entities.insert(newId);
-	return { *this, newId };
+	std::lock_guard lock{ m_DeferredMutex };
+	return { *this, m_Entities.Create() };
+}
+
+void EntityRegistry::CreateEntities(size_t amount, entityId* pIds)
+{
+	std::lock_guard lock{ m_DeferredMutex };
+	m_Entities.Create(amount, pIds);
+}
+
+std::vector<entityId> EntityRegistry::Instantiate(const Prefab& prefab, size_t amount)
+{
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Prefabs can not be instantiated in a registry using StorageMode::Archetypes");
+
+	std::vector<entityId> entities(amount);
+	CreateEntities(amount, entities.data());
+
+	for (const Prefab::Entry& entry : prefab.GetComponents())
+		GetOrCreateView(entry.typeId)->AddEntities(entities.data(), amount, entry.component);
+
+	return entities;
+}
+
+std::vector<entityId> EntityRegistry::TransferEntities(std::span<const entityId> ids, EntityRegistry& target)
+{
+	if (m_pArchetypeStorage || target.m_pArchetypeStorage)
+		throw std::runtime_error("Entities can not be transferred between registries using StorageMode::Archetypes");
+
+	if (&target == this)
+		throw std::invalid_argument("Entities can not be transferred to the registry they are in");
+
+	// A duplicate would read the moved-from Components of the entity a second time
+	SparseSet transferred;
+	transferred.reserve(ids.size());
+	for (entityId id : ids)
+	{
+		if (!IsAlive(id))
+			throw std::invalid_argument("Entity " + std::to_string(id) + " can not be transferred because it is not alive");
+		if (transferred.contains(id))
+			throw std::invalid_argument("Entity " + std::to_string(id) + " can not be transferred more than once");
+		transferred.push_back(id);
+	}
+
+	std::vector<entityId> targetIds(ids.size());
+	target.CreateEntities(targetIds.size(), targetIds.data());
+
+	// Collect the entities of every view using the signatures, so only the views the entities have a Component in are visited
+	std::vector<std::vector<size_t>> viewEntities(m_ViewsByIndex.size());
+	for (size_t i{}; i < ids.size(); ++i)
+		m_Signatures.ForEach(ids[i], [&viewEntities, i](size_t viewIndex) { viewEntities[viewIndex].emplace_back(i); });
+
+	std::vector<entityId> sourceBatch;
+	std::vector<entityId> targetBatch;
+	for (size_t viewIndex{}; viewIndex < m_ViewsByIndex.size(); ++viewIndex)
+	{
+		const std::vector<size_t>& entities{ viewEntities[viewIndex] };
+		if (entities.empty())
+			continue;
+
+		sourceBatch.resize(entities.size());
+		targetBatch.resize(entities.size());
+		for (size_t i{}; i < entities.size(); ++i)
+		{
+			sourceBatch[i] = ids[entities[i]];
+			targetBatch[i] = targetIds[entities[i]];
+		}
+
+		TypeViewBase* view{ m_ViewsByIndex[viewIndex] };
+		view->MoveEntities(sourceBatch.data(), sourceBatch.size(), *target.GetOrCreateView(view->GetTypeId()), targetBatch.data());
+	}
+
+	// The entities are only removed after all their Components were moved, as removing moves the Components of owning groups in the other views
+	for (size_t viewIndex{}; viewIndex < m_ViewsByIndex.size(); ++viewIndex)
+	{
+		for (size_t i : viewEntities[viewIndex])
+			m_ViewsByIndex[viewIndex]->Remove(ids[i]);
+	}
+
+	for (entityId id : ids)
+		m_Entities.Remove(id);
+
+	return targetIds;
 }
 
 void EntityRegistry::RemoveEntity(const Entity& entity)
@@ -167,17 +319,18 @@ void EntityRegistry::RemoveEntity(const Entity& entity)
 
 void EntityRegistry::RemoveEntity(entityId id)
 {
-	if (id != Entity::InvalidId && m_Entities.contains(id))
-		m_RemovedEntities.emplace_back(id);
+	// Whether the entity is alive is checked during playback, as entities may be created concurrently
+	if (id != Entity::InvalidId)
+		GetCommandBuffer().RemoveEntity(id);
 }
 
 const Entity EntityRegistry::CreateOrGetEntity(entityId id)
 {
 	assert(id != Entity::InvalidId);
-	auto it = m_Entities.find(id);
-	if (it == m_Entities.end())
+	if (!m_Entities.contains(id))
 	{
-		m_Entities.emplace(id);
+		[[maybe_unused]] const bool inserted{ m_Entities.Insert(id) };
+		assert(inserted); // The index of the id is used by an entity of a different generation
 	}
 	return Entity(*this, id);
 }
@@ -209,105 +362,210 @@ TypeBinding* EntityRegistry::GetOrCreateBinding(const uint32_t* types, const siz
 	return AddBinding(types, size);
 }
 
-void EntityRegistry::Update(float deltaTime)
+TypeBinding* EntityRegistry::AddGroup(const uint32_t* typeIds, size_t size)
 {
-	for (auto& typeView : m_TypeViews)
+	TypeBinding* binding{ GetOrCreateBinding(typeIds, size) };
+	binding->Own();
+	return binding;
+}
+
+void EntityRegistry::RegisterView(TypeViewBase* view)
+{
+	view->m_ViewIndex = m_ViewsByIndex.size();
+	view->m_pChangeTick = &m_ChangeTick;
+	m_ViewsByIndex.emplace_back(view);
+	m_Signatures.SetTypeAmount(m_ViewsByIndex.size());
+
+	// Registered before any binding, so the signature is already updated when the bindings are notified
+	const size_t viewIndex{ view->m_ViewIndex };
+	view->OnElementAdd.emplace_back([this, viewIndex](TypeViewBase*, entityId id) { m_Signatures.Set(id, viewIndex); });
+	view->OnElementsAdd.emplace_back([this, viewIndex](TypeViewBase*, std::span<const entityId> ids)
+		{
+			for (entityId id : ids)
+				m_Signatures.Set(id, viewIndex);
+		});
+	view->OnElementRemove.emplace_back([this, viewIndex](TypeViewBase*, entityId id) { m_Signatures.Reset(id, viewIndex); });
+}
+
+void EntityRegistry::EmplaceSystem(SystemBase* system)
+{
+	system->SetJobSystem(m_pJobSystem);
+	m_Systems.emplace(system);
+	m_SystemScheduler.Invalidate();
+}
+
+CommandBuffer& EntityRegistry::GetCommandBuffer()
+{
+	if (t_LastRegistryId == m_RegistryId)
+		return *t_pLastCommandBuffer;
+
+	CommandBuffer*& buffer{ t_CommandBuffers[m_RegistryId] };
+	if (!buffer)
 	{
-		if (typeView.second->GetDataFlag() == ViewDataFlag::dirty)
+		std::lock_guard lock{ m_DeferredMutex };
+		buffer = m_CommandBuffers.emplace_back(std::make_unique<CommandBuffer>(m_CommandSequence)).get();
+	}
+
+	t_LastRegistryId = m_RegistryId;
+	t_pLastCommandBuffer = buffer;
+	return *buffer;
+}
+
+void EntityRegistry::PlaybackCommands()
+{
+	// Components that are initialized during playback may record new commands, those are played back during the next Update
+	std::vector<size_t> playedAmounts(m_CommandBuffers.size());
+	m_PlaybackCommands.clear();
+	for (size_t i{}; i < m_CommandBuffers.size(); ++i)
+	{
+		const auto& commands = m_CommandBuffers[i]->GetCommands();
+		m_PlaybackCommands.insert(m_PlaybackCommands.end(), commands.begin(), commands.end());
+		playedAmounts[i] = commands.size();
+	}
+
+	// Sorting makes the result independent of the thread that recorded a command and of the order of the buffers.
+	// The entities are removed first, then the commands of every Component of an entity are played back in the order they were recorded in
+	std::stable_sort(m_PlaybackCommands.begin(), m_PlaybackCommands.end(), [](const CommandBuffer::Command& c0, const CommandBuffer::Command& c1)
 		{
-			for (size_t i{}; i < ThreadPoolSize; ++i)
+			const bool keeps0{ c0.type != CommandBuffer::CommandType::RemoveEntity };
+			const bool keeps1{ c1.type != CommandBuffer::CommandType::RemoveEntity };
+			return std::tie(keeps0, c0.id, c0.typeId, c0.sequence) < std::tie(keeps1, c1.id, c1.typeId, c1.sequence);
+		});
+
+	for (size_t i{}; i < m_PlaybackCommands.size(); ++i)
+	{
+		const auto& command = m_PlaybackCommands[i];
+		switch (command.type)
+		{
+		case CommandBuffer::CommandType::RemoveEntity:
+			if (!m_Entities.Remove(command.id))
+				break; // already removed
+
+			if (m_pArchetypeStorage)
+				m_pArchetypeStorage->RemoveEntity(command.id);
+			else
+				// Only the views the entity has a Component in are visited
+				m_Signatures.ForEach(command.id, [this, &command](size_t viewIndex) { m_ViewsByIndex[viewIndex]->Remove(command.id); });
+			break;
+
+		case CommandBuffer::CommandType::RemoveComponent:
+			if (m_Entities.contains(command.id))
+				RemoveComponentInstantly(command.typeId, command.id);
+			break;
+
+		case CommandBuffer::CommandType::AddComponent:
+			if (!m_Entities.contains(command.id))
+				break;
+
+			// When the same Component is added again before it is removed, the last recorded Component is kept
+			if (i + 1 < m_PlaybackCommands.size())
 			{
-				auto& progress = m_SortingProgress[i];
-				if (progress == SortingProgress::none)
-				{
-					auto& quitBool{ m_SortingThreadPool.GetQuitBool() };
-					m_SortingThreadPool.AddFunction([&typeView, &progress, &quitBool] {typeView.second->SortData(progress, quitBool); });
+				const auto& next = m_PlaybackCommands[i + 1];
+				if (next.type == CommandBuffer::CommandType::AddComponent && next.id == command.id && next.typeId == command.typeId)
 					break;
-				}
 			}
-		}
-	}
 
-	for (size_t i{}; i < ThreadPoolSize; ++i)
-	{
-		auto& progress = m_SortingProgress[i];
-		switch (progress)
-		{
-		case SortingProgress::done:
+			if (m_pArchetypeStorage)
 			{
-			progress = SortingProgress::copying;
-				while (progress != SortingProgress::none)
-				{}
+				RegisterArchetypeComponent(*command.info);
+				m_pArchetypeStorage->AddComponent(command.id, command.typeId, command.data);
+			}
+			else
+			{
+				TypeViewBase* view{ GetOrCreateView(command.typeId) };
+				if (!view->Contains(command.id))
+					view->AddEntity(command.id, command.data);
 			}
-			break;
-		case SortingProgress::canceled:
-			progress = SortingProgress::none;
 			break;
 		}
 	}
+	m_PlaybackCommands.clear();
 
-	// Update systems
-	for (auto& system : m_Systems)
-	{
+	for (size_t i{}; i < playedAmounts.size(); ++i)
+		m_CommandBuffers[i]->Release(playedAmounts[i]);
+}
+
+void EntityRegistry::UpdateSystem(SystemBase* system, float deltaTime)
+{
 #ifdef SYSTEM_PROFILER
-		auto begin = std::chrono::high_resolution_clock::now();
-		system->Update(deltaTime);
-		auto end = std::chrono::high_resolution_clock::now();
+	auto begin = std::chrono::high_resolution_clock::now();
+	const bool isExecuted{ system->Update(deltaTime) };
+	auto end = std::chrono::high_resolution_clock::now();
 
-		if (!m_ProfilerInfo.contains(system->GetSystemParameters().name))
-			m_ProfilerInfo.emplace(system->GetSystemParameters().name, ProfilerInfo{ system.get() });
+	std::lock_guard lock{ m_ProfilerMutex };
+	if (!m_ProfilerInfo.contains(system->GetSystemParameters().name))
+		m_ProfilerInfo.emplace(system->GetSystemParameters().name, ProfilerInfo{ system });
 
-		// If leftover deltaTime is smaller than given DeltaTime it means it executed
-		if (system->GetAccumulatedTime() < deltaTime)
-		{
-			float updateInterval = system->GetSystemParameters().updateInterval;
-			int timeAdjustment = (updateInterval >= 0.0001f) ? int(updateInterval / deltaTime) : 1;
+	// If leftover deltaTime is smaller than given DeltaTime it means it executed
+	if (system->GetAccumulatedTime() < deltaTime)
+	{
+		float updateInterval = system->GetSystemParameters().updateInterval;
+		int timeAdjustment = (updateInterval >= 0.0001f) ? int(updateInterval / deltaTime) : 1;
 
-			auto& profilerInfo = m_ProfilerInfo.find(system->GetSystemParameters().name)->second;
-			++profilerInfo.timesExecuted;
-			profilerInfo.timeToExecuteSystem = std::chrono::milliseconds((end - begin).count() / timeAdjustment);
-			profilerInfo.timeToExecutePerComponent = profilerInfo.timeToExecuteSystem / system->GetEntityAmount() / timeAdjustment;
-		}
+		auto& profilerInfo = m_ProfilerInfo.find(system->GetSystemParameters().name)->second;
+		++profilerInfo.timesExecuted;
+		profilerInfo.timeToExecuteSystem = std::chrono::milliseconds((end - begin).count() / timeAdjustment);
+		profilerInfo.timeToExecutePerComponent = profilerInfo.timeToExecuteSystem / system->GetEntityAmount() / timeAdjustment;
+	}
 #else
-		system->Update(deltaTime);
+	const bool isExecuted{ system->Update(deltaTime) };
 #endif
-	}
 
-	// Remove deleted entities
-	for (auto id : m_RemovedEntities)
+	// Systems write to their Components through references, so every Component the system may write to counts as changed.
+	// Systems executed concurrently never write to the same Components, so they never mark the same view
+	if (isExecuted && !m_pArchetypeStorage)
 	{
-		m_Entities.erase(id);
-		for (auto& view : m_TypeViews)
+		for (uint32_t typeId : system->GetAccess().writeTypes)
 		{
-			if (view.second->Contains(id))
-			{
-				view.second->Remove(id);
-			}
+			auto it = m_TypeViews.find(typeId);
+			if (it != m_TypeViews.end())
+				it->second->MarkAllChanged();
 		}
 	}
-	m_RemovedEntities.clear();
+}
 
-	// Remove deleted components
-	for (auto& idComp : m_RemovedComponents)
+void EntityRegistry::Update(float deltaTime)
+{
+	// Sort the views that became unsorted, every view is sorted by its own job
+	std::vector<TypeViewBase*> unsortedViews;
+	for (auto& typeView : m_TypeViews)
 	{
-		auto it = m_TypeViews.find(idComp.first);
-		if (it != m_TypeViews.end())
-		{
-			it->second->Remove(idComp.second);
-		}
+		if (typeView.second->GetDataFlag() == ViewDataFlag::dirty)
+			unsortedViews.emplace_back(typeView.second.get());
 	}
-	m_RemovedComponents.clear();
+
+	m_pJobSystem->ParallelFor(0, unsortedViews.size(), 1, [&unsortedViews](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+				unsortedViews[i]->SortData();
+		});
+
+	// Rebuild the spatial indices of which the Components changed, so the systems query the positions of the previous update
+	for (auto& spatialIndex : m_SpatialIndices)
+		spatialIndex->Update();
+
+	// Update systems
+	m_SystemScheduler.Execute(m_Systems, [this, deltaTime](SystemBase* system) { UpdateSystem(system, deltaTime); });
+
+	// Apply the structural changes that were recorded by the systems
+	PlaybackCommands();
 
 	// Update Type views
 	for (auto& typeView : m_TypeViews)
 	{
 		typeView.second->Update(deltaTime);
 	}
+
+	if (m_pArchetypeStorage)
+		m_pArchetypeStorage->Update(deltaTime);
 		
 }
 
 void EntityRegistry::Serialize(std::ostream& stream) const
 {
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Serializing is not supported by registries using StorageMode::Archetypes");
+
 	{ // Get amount of systems that are not subsystems or default systems
 		size_t SystemAmount{  };
 		for (auto& system : m_Systems)
@@ -331,16 +589,172 @@ void EntityRegistry::Serialize(std::ostream& stream) const
 		WriteStream(stream, entity);
 	}
 
-	WriteStream(stream, m_TypeViews.size());
+	// Serialize the views into separate buffers on the job system and write them in order
+	std::vector<TypeViewBase*> typeViews;
+	typeViews.reserve(m_TypeViews.size());
 	for (auto& typeView : m_TypeViews)
+		typeViews.emplace_back(typeView.second.get());
+
+	std::vector<std::stringstream> buffers(typeViews.size());
+	m_pJobSystem->ParallelFor(0, typeViews.size(), 1, [&typeViews, &buffers](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+				typeViews[i]->SerializeView(buffers[i]);
+		});
+
+	WriteStream(stream, m_TypeViews.size());
+	for (size_t i{}; i < typeViews.size(); ++i)
 	{
-		WriteStream(stream, typeView.first);
-		typeView.second->SerializeView(stream);
+		WriteStream(stream, typeViews[i]->GetTypeId());
+		const std::string data{ buffers[i].str() };
+		stream.write(data.data(), data.size());
+	}
+}
+
+void EntityRegistry::TakeSnapshot(RegistrySnapshot& snapshot, const RegistrySnapshot* previous)
+{
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Snapshots are not supported by registries using StorageMode::Archetypes");
+
+	if (previous && !previous->IsValid())
+		previous = nullptr;
+
+	// Components marked from now on have a higher tick than the snapshot
+	const ChangeTicks::Tick tick{ AdvanceChangeTick() };
+	snapshot.m_Tick = tick;
+
+	if (previous && previous->m_Entities->GetVersion() == m_Entities.GetVersion())
+		snapshot.m_Entities = previous->m_Entities;
+	else
+		RegistrySnapshot::MakeUnique(snapshot.m_Entities) = m_Entities;
+
+	const std::shared_ptr<ViewSnapshot> none{};
+	snapshot.m_Views.resize(m_ViewsByIndex.size());
+	m_pJobSystem->ParallelFor(0, m_ViewsByIndex.size(), 1, [this, &snapshot, previous, &none, tick](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+			{
+				const bool hasPrevious{ previous && i < previous->m_Views.size() };
+				m_ViewsByIndex[i]->TakeSnapshot(snapshot.m_Views[i], hasPrevious ? previous->m_Views[i] : none, tick);
+			}
+		});
+
+	snapshot.m_Bindings.resize(m_TypeBindings.size());
+	for (size_t i{}; i < m_TypeBindings.size(); ++i)
+	{
+		const TypeBinding* binding{ m_TypeBindings[i].get() };
+		if (previous && i < previous->m_Bindings.size() && previous->m_Bindings[i]->version == binding->GetVersion())
+		{
+			snapshot.m_Bindings[i] = previous->m_Bindings[i];
+			continue;
+		}
+
+		auto& bindingSnapshot{ RegistrySnapshot::MakeUnique(snapshot.m_Bindings[i]) };
+		bindingSnapshot.entities = binding->GetElementEntities();
+		bindingSnapshot.version = binding->GetVersion();
+	}
+}
+
+void EntityRegistry::RestoreSnapshot(const RegistrySnapshot& snapshot)
+{
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Snapshots are not supported by registries using StorageMode::Archetypes");
+
+	if (!snapshot.IsValid())
+		throw std::runtime_error("The snapshot was not taken");
+
+	if (m_Entities.GetVersion() != snapshot.m_Entities->GetVersion())
+		m_Entities = *snapshot.m_Entities;
+
+	// Only the views that changed are restored, the signatures of the views of which the entities change are updated here
+	// as the views do not call their callbacks while restoring.
+	// The data of the unchanged views is still copied back, as writes without MarkChanged are not found by the change ticks
+	std::vector<TypeViewBase*> restoredViews;
+	std::vector<TypeViewBase*> unchangedViews;
+	std::vector<bool> entitiesChanged(m_ViewsByIndex.size());
+	for (size_t i{}; i < m_ViewsByIndex.size(); ++i)
+	{
+		TypeViewBase* view{ m_ViewsByIndex[i] };
+		const ViewSnapshot* viewSnapshot{ i < snapshot.m_Views.size() ? snapshot.m_Views[i].get() : nullptr };
+		if (viewSnapshot ? view->IsUnchangedSince(*viewSnapshot) : view->GetSize() == 0)
+		{
+			if (viewSnapshot && view->GetSize() > 0)
+				unchangedViews.emplace_back(view);
+			continue;
+		}
+
+		restoredViews.emplace_back(view);
+		if (!view->HasEntitiesOf(viewSnapshot))
+		{
+			entitiesChanged[i] = true;
+			for (entityId id : view->GetRegisteredEntities())
+				m_Signatures.Reset(id, i);
+		}
+	}
+
+	m_pJobSystem->ParallelFor(0, restoredViews.size() + unchangedViews.size(), 1, [&restoredViews, &unchangedViews, &snapshot](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+			{
+				if (i >= restoredViews.size())
+				{
+					TypeViewBase* view{ unchangedViews[i - restoredViews.size()] };
+					view->RestoreData(*snapshot.m_Views[view->GetViewIndex()]);
+					continue;
+				}
+
+				const size_t viewIndex{ restoredViews[i]->GetViewIndex() };
+				restoredViews[i]->RestoreSnapshot(viewIndex < snapshot.m_Views.size() ? snapshot.m_Views[viewIndex].get() : nullptr);
+			}
+		});
+
+	for (size_t i{}; i < m_ViewsByIndex.size(); ++i)
+	{
+		if (entitiesChanged[i])
+		{
+			for (entityId id : m_ViewsByIndex[i]->GetRegisteredEntities())
+				m_Signatures.Set(id, i);
+		}
+	}
+
+	// A binding is restored when the entities of one of its views changed or when its elements were reordered
+	for (size_t i{}; i < m_TypeBindings.size(); ++i)
+	{
+		TypeBinding* binding{ m_TypeBindings[i].get() };
+		size_t typeAmount{};
+		const uint32_t* types{ binding->GetTypeIds(typeAmount) };
+
+		bool isChanged{ false };
+		for (size_t type{}; type < typeAmount && !isChanged; ++type)
+			isChanged = entitiesChanged[GetTypeView(types[type])->GetViewIndex()];
+
+		if (i < snapshot.m_Bindings.size())
+		{
+			const auto& bindingSnapshot{ *snapshot.m_Bindings[i] };
+			if (isChanged || (binding->GetVersion() != bindingSnapshot.version && binding->GetElementEntities() != bindingSnapshot.entities))
+				binding->Restore(bindingSnapshot.entities);
+		}
+		else if (isChanged)
+		{
+			// The binding did not exist when the snapshot was taken, its elements are found using the entities of its first view
+			const std::span<const entityId> registered{ GetTypeView(types[0])->GetRegisteredEntities() };
+			const std::vector<entityId> entities(registered.begin(), registered.end());
+			binding->Restore(entities);
+		}
+	}
+
+	for (auto& index : m_SpatialIndices)
+	{
+		if (std::ranges::find(restoredViews, GetTypeView(index->GetTypeId())) != restoredViews.end())
+			index->MarkDirty();
 	}
 }
 
 void EntityRegistry::Deserialize(std::istream& stream)
 {
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Deserializing is not supported by registries using StorageMode::Archetypes");
+
 	size_t systemAmount{};
 	ReadStream(stream, systemAmount);
 	for (size_t i{}; i < systemAmount; ++i)
@@ -362,7 +776,7 @@ void EntityRegistry::Deserialize(std::istream& stream)
 	{
 		entityId id{};
 		ReadStream(stream, id);
-		m_Entities.emplace(id);
+		m_Entities.Insert(id);
 	}
 
 	size_t viewsAmount{};
@@ -380,6 +794,9 @@ void EntityRegistry::Deserialize(std::istream& stream)
 VoidReference EntityRegistry::GetComponent(uint32_t typeId, entityId id)
 {
 	assert(id != Entity::InvalidId);
+	if (m_pArchetypeStorage)
+		return m_pArchetypeStorage->GetComponent(id, typeId);
+
 	auto it = m_TypeViews.find(typeId);
 	if (it != m_TypeViews.end())
 	{
@@ -402,6 +819,13 @@ VoidReference EntityRegistry::AddComponentInstantly(uint32_t typeId, entityId id
 {
 	assert(id != Entity::InvalidId);
 	assert(m_Entities.contains(id));
+
+	if (m_pArchetypeStorage)
+	{
+		RegisterArchetypeComponent(typeId);
+		return m_pArchetypeStorage->AddComponent(id, typeId);
+	}
+
 	auto it = m_TypeViews.find(typeId);
 	if (it != m_TypeViews.end())
 	{
@@ -422,18 +846,13 @@ void* EntityRegistry::AddComponent(uint32_t typeId, const Entity& entity)
 void* EntityRegistry::AddComponent(uint32_t typeId, entityId id)
 {
 	assert(id != Entity::InvalidId);
-	assert(m_Entities.contains(id));
-	
-	auto it = m_TypeViews.find(typeId);
-	if (it != m_TypeViews.end())
-	{
-		return it->second->AddAfterUpdate_void(id);
-	}
-	else
-	{
-		AddView(typeId);
-		return AddComponent(typeId, id);
-	}
+
+	auto& componentInfos = ECSTypeInformation::GetArchetypeComponentInfos();
+	auto it = componentInfos.find(typeId);
+	if (it == componentInfos.end())
+		throw std::runtime_error("Component has to be registered using RegisterClass<> to be added using its typeId");
+
+	return GetCommandBuffer().AddComponent(id, it->second);
 }
 
 void EntityRegistry::RemoveComponent(uint32_t typeId, const Entity& entity)
@@ -443,7 +862,7 @@ void EntityRegistry::RemoveComponent(uint32_t typeId, const Entity& entity)
 
 void EntityRegistry::RemoveComponent(uint32_t typeId, entityId id)
 {
-	m_RemovedComponents.emplace_back(typeId, id);
+	GetCommandBuffer().RemoveComponent(id, typeId);
 }
 
 void EntityRegistry::RemoveComponentInstantly(uint32_t typeId, const Entity& entity)
@@ -453,7 +872,11 @@ void EntityRegistry::RemoveComponentInstantly(uint32_t typeId, const Entity& ent
 
 void EntityRegistry::RemoveComponentInstantly(uint32_t typeId, entityId id)
 {
-	m_Entities.erase(id);
+	if (m_pArchetypeStorage)
+	{
+		m_pArchetypeStorage->RemoveComponent(id, typeId);
+		return;
+	}
 
 	auto it = m_TypeViews.find(typeId);
 	if (it != m_TypeViews.end())
@@ -536,9 +959,11 @@ bool EntityRegistry::IsEnabled(uint32_t typeId, const VoidReference& component)
 
 void EntityRegistry::EnableEntity(entityId id)
 {
-	for (auto& view : m_TypeViews)
-		if (view.second->Contains(id))
-			view.second->Enable(id);
+	// The signatures are indexed by the entity index only, a removed entity would reach the views of the entity reusing its index
+	if (!IsAlive(id))
+		return;
+
+	m_Signatures.ForEach(id, [this, id](size_t viewIndex) { m_ViewsByIndex[viewIndex]->Enable(id); });
 }
 
 void EntityRegistry::EnableEntity(const Entity& entity)
@@ -548,12 +973,34 @@ void EntityRegistry::EnableEntity(const Entity& entity)
 
 void EntityRegistry::DisableEntity(entityId id)
 {
-	for (auto& view : m_TypeViews)
-		if (view.second->Contains(id))
-			view.second->Disable(id);
+	if (!IsAlive(id))
+		return;
+
+	m_Signatures.ForEach(id, [this, id](size_t viewIndex) { m_ViewsByIndex[viewIndex]->Disable(id); });
 }
 
 void EntityRegistry::DisableEntity(const Entity& entity)
 {
 	DisableEntity(entity.GetId());
 }
+
+void EntityRegistry::RegisterArchetypeComponent(const ArchetypeComponentInfo& info)
+{
+	assert(m_pArchetypeStorage);
+	if (m_pArchetypeStorage->RegisterComponent(info))
+		AddDefaultSystems(info.typeId);
+}
+
+void EntityRegistry::RegisterArchetypeComponent(uint32_t typeId)
+{
+	assert(m_pArchetypeStorage);
+	if (m_pArchetypeStorage->IsRegistered(typeId))
+		return;
+
+	auto& componentInfos = ECSTypeInformation::GetArchetypeComponentInfos();
+	auto it = componentInfos.find(typeId);
+	if (it == componentInfos.end())
+		throw std::runtime_error("Component has to be registered using RegisterClass<> to be added using its typeId");
+
+	RegisterArchetypeComponent(it->second);
+}
@@ -7,15 +7,40 @@
 #include <stdexcept>
 #include <fstream>
 #include <set>
-#include <unordered_set>
 #include <sstream>
+#include <mutex>
+#include <atomic>
+#include <tuple>
+#include <type_traits>
+#include <span>
 
 #include "../TypeInformation/reflection.h"
 #include "../TypeInformation/TypeInformation.h"
-#include "../Sorting/SorterThreadPool.h"
+#include "../Jobs/JobSystem.h"
+#include "../Entity/EntityPool.h"
+#include "../Entity/ComponentSignatures.h"
 #include "TypeBinding.h"
 #include "TypeView.h"
+#include "CommandBuffer.h"
+#include "Resources.h"
+#include "SpatialIndex.h"
+#include "Prefab.h"
+#include "Snapshot.h"
 #include "../System/System.h"
+#include "../System/SystemScheduler.h"
+
+/**
+ * The way the Components of a registry are stored
+ * - TypeViews: every Component type is stored inside of its own TypeView and multiple Components are joined using TypeBindings
+ * - Archetypes: entities with the same Components are stored together inside of the chunks of an Archetype (see ArchetypeStorage.h).
+ *   Dynamic systems (AddSystem using a function) and default systems are executed by iterating the chunks of the matching Archetypes.
+ *   Custom systems have to derive from ArchetypeSystem. TypeViews, TypeBindings, enabling/disabling Components and serialization are not available.
+ */
+enum class StorageMode : uint8_t
+{
+	TypeViews,
+	Archetypes,
+};
 
 class EntityRegistry final
 {
@@ -33,8 +58,8 @@ public:
 
 public:
 
-	EntityRegistry() = default;
-	~EntityRegistry();
+	EntityRegistry(StorageMode storageMode = StorageMode::TypeViews);
+	~EntityRegistry() = default;
 
 	EntityRegistry(const EntityRegistry&)				= delete;
 	EntityRegistry(EntityRegistry&&)					= delete;
@@ -61,10 +86,32 @@ public:
 	template <typename... Components>
 	SystemBase* AddSystem(const SystemParameters& parameters, const std::function<void(float, Components&...)>& functionDT, bool AddSubSystems = true) requires (sizeof...(Components) >= 2);
 
+	/**
+	 * Add Dynamic System using a function object of any type, like a lambda, taking the Components and optionally deltaTime as first parameter.
+	 * The type of the function is kept inside of the system, so the call can be inlined unlike with the std::function overloads.
+	 * Resources given as Resource<T> template arguments are passed to the function after the Components and are added to the access of the system,
+	 * they have to be added to the registry before the system.
+	 */
+	template <typename... Components, typename Function>
+	SystemBase* AddSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems = true) requires SystemCallable<Function, Components...>;
+
 	/** Add the specific System to the Registry given as the template parameter*/
 	template <typename System>
 	SystemBase* AddSystem(const SystemParameters& parameters, bool AddSubSystems = true) requires std::is_base_of_v<SystemBase, System>;
 
+	/** Add a reactive system calling the function on every entity the Component was added to or removed from since its previous execution*/
+	template <typename Component>
+	SystemBase* AddReactiveSystem(const SystemParameters& parameters, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function);
+	SystemBase* AddReactiveSystem(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function);
+
+	/**
+	 * Creates a storage collecting the entities the Component (or one of its sub classes) is added to or removed from.
+	 * The storage lives as long as the registry and has to be cleared by its user.
+	 */
+	template <typename Component>
+	ObserverStorage* AddObserver(ObserverEvent event);
+	ObserverStorage* AddObserver(uint32_t typeId, ObserverEvent event);
+
 	/** Adds the default systems associated to the Component*/
 	template <typename Component>
 	void AddDefaultSystems();
@@ -113,6 +160,16 @@ public:
 	 */
 	void RemoveSystem(std::string name);
 
+	/**
+	 * Sets whether the systems are executed one after another or concurrently when they do not access the same Components (see SystemScheduler.h).
+	 * Systems executed in parallel may only use the deferred functions of the registry (CreateEntity, RemoveEntity, AddComponent and RemoveComponent),
+	 * which record into the command buffer of their thread.
+	 */
+	void SetSystemExecution(SystemExecution execution) { m_SystemScheduler.SetExecution(execution); }
+	SystemExecution GetSystemExecution() const { return m_SystemScheduler.GetExecution(); }
+
+	const SystemScheduler& GetSystemScheduler() const { return m_SystemScheduler; }
+
 	/**
 	 * VIEWS
 	 */
@@ -150,19 +207,102 @@ public:
 	/** Get a list of all the TypeViews inside the Registry*/
 	const auto& GetTypeViews() const { return m_TypeViews; }
 
+	/** Returns the view with the given dense index (see TypeViewBase::GetViewIndex())*/
+	TypeViewBase* GetTypeViewFromIndex(size_t viewIndex) const { return m_ViewsByIndex[viewIndex]; }
+
+	/** Returns the bitsets of the views every entity has a Component in, indexed by the view index of the views*/
+	const ComponentSignatures& GetSignatures() const { return m_Signatures; }
+
+	/**
+	 * RESOURCES
+	 */
+
+	/** Adds the single instance of the resource, constructed using the arguments. The resource may not exist yet*/
+	template <typename T, typename... Arguments>
+	T& AddResource(Arguments&&... arguments) { return m_Resources.Add<T>(std::forward<Arguments>(arguments)...); }
+
+	/** Returns the resource, throws if it does not exist. The resource does not move until it is removed*/
+	template <typename T>
+	T& GetResource() const { return m_Resources.Get<T>(); }
+
+	/** Returns the resource or nullptr if it does not exist*/
+	template <typename T>
+	T* FindResource() const { return m_Resources.Find<T>(); }
+
+	template <typename T>
+	bool ContainsResource() const { return m_Resources.Contains<T>(); }
+
+	/** Resources may not be removed while systems using them exist*/
+	template <typename T>
+	void RemoveResource() { m_Resources.Remove<T>(); }
+
+	/**
+	 * CHANGE DETECTION
+	 */
+
+	/** The tick that Components are marked with when they are added or changed*/
+	ChangeTicks::Tick GetChangeTick() const { return m_ChangeTick.load(std::memory_order_relaxed); }
+
+	/** Starts a new tick and returns the previous one, changes made from now on are newer than the returned tick*/
+	ChangeTicks::Tick AdvanceChangeTick() { return m_ChangeTick.fetch_add(1, std::memory_order_relaxed); }
+
+	/** Marks the Component of the entity as changed, only the Components written to by systems are marked automatically*/
+	template <typename Component>
+	void MarkChanged(entityId id);
+	void MarkChanged(uint32_t typeId, entityId id);
+
+	/**
+	 * SPATIAL INDICES
+	 */
+
+	/**
+	 * Adds a uniform grid of the positions of the Components (see SpatialPosition), which answers range and nearest neighbour queries.
+	 * The grid is rebuilt at the start of Update when the Components changed, Components that moved outside of systems have to be marked using MarkChanged.
+	 */
+	template <typename Component> requires Spatial<Component>
+	SpatialIndex<Component>* AddSpatialIndex(float cellSize);
+
+	/** Returns the spatial index of the Component or nullptr if it has none*/
+	template <typename Component>
+	const SpatialIndexBase* GetSpatialIndex() const { return GetSpatialIndex(reflection::type_id<Component>()); }
+	const SpatialIndexBase* GetSpatialIndex(uint32_t typeId) const;
+
 	/**
 	 * ENTITIES
 	 */
 
-	/** Creates an Entities that is linked to the Registry*/
+	/** Creates an Entities that is linked to the Registry. Can be called by systems executing in parallel*/
 	Entity CreateEntity();
 
-	/** Removes the Entities from the Registry and removes its components*/
+	/** Creates amount entities and writes their ids to pIds. Can be called by systems executing in parallel*/
+	void CreateEntities(size_t amount, entityId* pIds);
+
+	/** Removes the Entities from the Registry and removes its components at the end of the Update cycle*/
 	void RemoveEntity(const Entity& entity);
 	void RemoveEntity(entityId id);
 
 	/** Gets the container with all the Entities*/
-	const std::unordered_set<entityId>& GetEntities() const { return m_Entities; }
+	const EntityPool& GetEntities() const { return m_Entities; }
+
+	/**
+	 * Creates amount entities with a copy of every Component of the prefab and returns their ids.
+	 * Every view is looked up once, grows at most once and is only notified after all of its Components were added.
+	 * Can not be called by systems executing in parallel.
+	 */
+	std::vector<entityId> Instantiate(const Prefab& prefab, size_t amount = 1);
+
+	/**
+	 * Moves the entities with all of their Components to the target registry and returns their new ids inside of the target, in the same order.
+	 * The Components are moved view by view: every view of the target grows at most once and is only notified after all of its Components were added.
+	 * Afterwards the entities are removed from this registry, References to their Components become invalid.
+	 * Commands recorded for the entities that were not played back yet are dropped. Can not be called during the Update of either registry.
+	 * @throws std::runtime_error: when one of the registries uses StorageMode::Archetypes
+	 * @throws std::invalid_argument: when one of the entities is not alive or is given more than once, or the target is this registry
+	 */
+	std::vector<entityId> TransferEntities(std::span<const entityId> ids, EntityRegistry& target);
+
+	/** Returns true if the entity has not been removed from the Registry*/
+	bool IsAlive(entityId id) const { return m_Entities.contains(id); }
 
 	/** Gets the entity from the Registry or creates it if it does not exist in the Registry*/
 	const Entity CreateOrGetEntity(entityId id);
@@ -198,9 +338,30 @@ public:
 	template <typename... Components>
 	[[nodiscard]] TypeBinding* GetOrCreateBinding();
 
+	/**
+	 * Returns the Component Binding of the given Components after making it an owning group (see TypeBinding::Own()).
+	 * The entities of the group are kept at the front of the views of the Components in the same order,
+	 * so Binding Systems using the same Components iterate over contiguous memory.
+	 * @throws std::runtime_error: when one of the views is already owned by a different group
+	 */
+	template <typename... Components>
+	TypeBinding* AddGroup();
+
+	/** Add an owning group using TypeIds instead of templates*/
+	TypeBinding* AddGroup(const uint32_t* typeIds, size_t size);
+
 	/** Returns the list of all Type Bindings inside the Registry*/
 	const auto& GetTypeBindings() const { return m_TypeBindings; }
 
+	/**
+	 * ARCHETYPES
+	 */
+
+	StorageMode GetStorageMode() const { return m_pArchetypeStorage ? StorageMode::Archetypes : StorageMode::TypeViews; }
+
+	/** Returns the Archetype storage or nullptr if the registry uses StorageMode::TypeViews*/
+	ArchetypeStorage* GetArchetypeStorage() const { return m_pArchetypeStorage.get(); }
+
 	/**
 	 * MISC
 	 */
@@ -208,12 +369,44 @@ public:
 	/** Updates the Registry using delta Time.*/
 	void Update(float deltaTime);
 
+	/**
+	 * Sets the job system used for sorting, parallel systems and serializing.
+	 * By default the registry uses the shared JobSystem::GetInstance(). The job system has to outlive the registry.
+	 */
+	void SetJobSystem(JobSystem& jobSystem);
+	JobSystem& GetJobSystem() const { return *m_pJobSystem; }
+
+	/**
+	 * Returns the command buffer of the calling thread, which records the deferred functions (RemoveEntity, AddComponent and RemoveComponent).
+	 * The buffers of all threads are played back during Update after the systems are executed:
+	 * first the entities are removed, then the Components are removed and added in the order of the entityIds.
+	 * The commands for the same Component of an entity are played back in the order they were recorded in, also when they were recorded by different threads.
+	 * When the same Component is added multiple times, the last recorded one is kept. Adding a Component the entity already has is ignored.
+	 */
+	CommandBuffer& GetCommandBuffer();
+
 	/** Serializes the Registry to the given stream.*/
 	void Serialize(std::ostream& stream) const;
 
 	/** Deserialize the Registry from the given stream.*/
 	void Deserialize(std::istream& stream);
 
+	/**
+	 * Copies the entities, Components and the order of the bindings into the snapshot, reusing the memory of the snapshot.
+	 * Views that did not change since previous was taken are shared with previous instead of being copied (see RegistrySnapshot).
+	 * Advances the change tick, so Components marked afterwards are copied by the next snapshot. Can not be called during Update.
+	 * @throws std::runtime_error: for registries using StorageMode::Archetypes and for Components that are not copyable
+	 */
+	void TakeSnapshot(RegistrySnapshot& snapshot, const RegistrySnapshot* previous = nullptr);
+
+	/**
+	 * Restores the entities and Components of the snapshot, views that did not change since the snapshot was taken are skipped.
+	 * References to Components of entities that exist in both states stay valid. Views added after the snapshot was taken are emptied.
+	 * Observers are not notified and the commands that were not played back yet are kept. Can not be called during Update.
+	 * @throws std::runtime_error: for registries using StorageMode::Archetypes and for snapshots that were not taken
+	 */
+	void RestoreSnapshot(const RegistrySnapshot& snapshot);
+
 #ifdef SYSTEM_PROFILER
 	const std::unordered_map<std::string, ProfilerInfo>& GetProfilerInfo() const { return m_ProfilerInfo; };
 #endif
@@ -238,7 +431,18 @@ public:
 	VoidReference AddComponentInstantly(uint32_t typeId, const Entity& entity);
 	VoidReference AddComponentInstantly(uint32_t typeId, entityId id);
 
-	/** Adds the component to the given entity at the end of the Update cycle*/
+	/**
+	 * Adds a copy of components[i] to the entity ids[i].
+	 * The view is looked up once, grows at most once and is only notified after all Components were added.
+	 * Can not be called by systems executing in parallel.
+	 */
+	template <typename Component>
+	void AddComponents(std::span<const entityId> ids, std::span<const Component> components);
+
+	/**
+	 * Adds the component to the given entity at the end of the Update cycle.
+	 * The returned Component is stored inside of the command buffer of the calling thread and may be modified until it is moved to the entity.
+	 */
 	template <typename Component>
 	Component* AddComponent(const Entity& entity);
 	template <typename Component>
@@ -246,7 +450,7 @@ public:
 	void* AddComponent(uint32_t typeId, const Entity& entity);
 	void* AddComponent(uint32_t typeId, entityId id);
 
-	/** Removes the component from the given Entities*/
+	/** Removes the component from the given Entities at the end of the Update cycle*/
 	template <typename Component>
 	void RemoveComponent(const Entity& entity);
 	template <typename Component>
@@ -309,17 +513,13 @@ private:
 	 * Systems Helper function
 	 */
 
-	template <typename Component>
-	void AddDynamicViewSubSystems(const SystemParameters& parameters, const std::function<void(Component&)>& function);
+	/** Adds a System for every sub class of the Component of the dynamic View System, constructed using the same function*/
+	template <typename System, typename Function>
+	void AddDynamicViewSubSystems(const SystemParameters& parameters, const Function& function);
 
-	template <typename... Components>
-	void AddDynamicBindingSubSystems(const SystemParameters& parameters, const std::function<void(Components&...)>& function);
-
-	template <typename Component>
-	void AddDynamicViewSubSystemsDT(const SystemParameters& parameters, const std::function<void(float, Component&)>& functionDT);
-
-	template <typename... Components>
-	void AddDynamicBindingSubSystemsDT(const SystemParameters& parameters, const std::function<void(float, Components&...)>& functionDT);
+	/** Adds a System for every combination of sub classes of the Components of the dynamic Binding System, constructed using the same function*/
+	template <typename System, typename Function>
+	void AddDynamicBindingSubSystems(const SystemParameters& parameters, const Function& function);
 
 	template <typename System>
 	SystemBase* AddViewSystem(const SystemParameters& parameters, bool AddSubSystems = true);
@@ -333,26 +533,89 @@ private:
 	template <typename System>
 	void AddBindingSubSystem(const SystemParameters& parameters);
 
+	template <typename System>
+	SystemBase* AddArchetypeSystem(System* system);
+
+	/** Adds the dynamic System of the Components for a function that does not take any resources*/
+	template <typename... Components, typename Function>
+	SystemBase* AddCallableSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems);
+
+	/** Adds the dynamic System of the Components with a function that gets the resources passed after the Components*/
+	template <typename Function, typename... Components, typename... ResourceTypes>
+	SystemBase* AddResourceSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems,
+		std::type_identity<std::tuple<Components...>>, std::type_identity<std::tuple<ResourceTypes...>>);
+
+	/** Gives the reactive system the observer and view of its Component*/
+	SystemBase* AddReactiveSystem(ReactiveSystemBase* system);
+
+	/** Adds the system to the systems of the registry and gives it the job system of the registry*/
+	void EmplaceSystem(SystemBase* system);
+
+	/** Gives the new view its dense index and keeps the signatures of the entities up to date with its Components*/
+	void RegisterView(TypeViewBase* view);
+
+	void UpdateSystem(SystemBase* system, float deltaTime);
+
+	/** Merges the command buffers of all threads and applies their commands (see GetCommandBuffer())*/
+	void PlaybackCommands();
+
+	/**
+	 * Archetype helper functions
+	 */
+
+	/** Registers the Component inside of the Archetype storage and adds its default systems the first time it is registered*/
+	void RegisterArchetypeComponent(const ArchetypeComponentInfo& info);
+	void RegisterArchetypeComponent(uint32_t typeId);
+
 
 private:
 
 	/** Entities*/
 
-	std::unordered_set<entityId> m_Entities;
-	size_t m_EntityCounter{};
+	EntityPool m_Entities;
+
+	/** Resources*/
+
+	ResourceStorage m_Resources;
+
+	/** Observers, declared before the views so they outlive the callbacks of the views pointing to them*/
+
+	std::vector<std::unique_ptr<ObserverStorage>> m_Observers;
+
+	/** Spatial indices, declared before the views for the same reason as the observers*/
+
+	std::vector<std::unique_ptr<SpatialIndexBase>> m_SpatialIndices;
 
 	/** Component views*/
 
 	std::unordered_map<uint32_t, std::unique_ptr<TypeViewBase>> m_TypeViews;
+	std::vector<TypeViewBase*> m_ViewsByIndex;
+	ComponentSignatures m_Signatures;
+
+	/** Starts at 1 so a query that never iterated (tick 0) sees every Component as added and changed*/
+	std::atomic<ChangeTicks::Tick> m_ChangeTick{ 1 };
 
 	/** Component bindings*/
 
 	std::vector<std::unique_ptr<TypeBinding>> m_TypeBindings;
 
-	/** Removing entities*/
+	/** Archetypes (only used with StorageMode::Archetypes)*/
+
+	std::unique_ptr<ArchetypeStorage> m_pArchetypeStorage;
+
+	/** Deferred commands*/
+
+	std::vector<std::unique_ptr<CommandBuffer>> m_CommandBuffers;
+	std::vector<CommandBuffer::Command> m_PlaybackCommands;
+	std::atomic<uint64_t> m_CommandSequence{};
 
-	std::vector<entityId> m_RemovedEntities;
-	std::vector<std::pair<uint32_t, entityId>> m_RemovedComponents;
+	/** Identifies the registry inside of the command buffers of the threads, unlike its address it is never reused*/
+	const uint64_t m_RegistryId{ s_RegistryCounter.fetch_add(1, std::memory_order_relaxed) };
+	inline static std::atomic<uint64_t> s_RegistryCounter{};
+
+	/** Jobs*/
+
+	JobSystem* m_pJobSystem{ &JobSystem::GetInstance() };
 
 	/** Systems*/
 
@@ -360,14 +623,14 @@ private:
 		decltype([](const std::unique_ptr<SystemBase>& v0, const std::unique_ptr<SystemBase>& v1)
 			{return v0->GetSystemParameters().executionTime < v1->GetSystemParameters().executionTime; }) > m_Systems;
 
-	/** Sorting*/
-	static constexpr size_t ThreadPoolSize{ 4 };
+	SystemScheduler m_SystemScheduler{ m_pJobSystem };
 
-	ThreadPool m_SortingThreadPool{ThreadPoolSize};
-	std::array<volatile SortingProgress, ThreadPoolSize> m_SortingProgress{};
+	/** Guards the creation of entities and command buffers by systems executing in parallel*/
+	std::mutex m_DeferredMutex;
 
 #ifdef SYSTEM_PROFILER
 	std::unordered_map<std::string, ProfilerInfo> m_ProfilerInfo;
+	std::mutex m_ProfilerMutex;
 #endif
 };
 
@@ -377,16 +640,19 @@ SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters, const
 	// Make sure the name is not in there already
 	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
 
-	auto view = &GetOrCreateView<Component>();
+	if (m_pArchetypeStorage)
+		return AddArchetypeSystem(new ArchetypeSystemDynamic<Component>{ parameters, function });
+
+	auto view = &GetOrCreateView<std::remove_const_t<Component>>();
 	auto system = new ViewSystemDynamic<Component>{ parameters, function };
 
 	system->SetTypeView(view);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
-		AddDynamicViewSubSystems<Component>(parameters, function);
+		AddDynamicViewSubSystems<ViewSystemDynamic<Component>>(parameters, function);
 
 	return system;
 }
@@ -397,16 +663,19 @@ SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters, const
 	// Make sure the name is not in there already
 	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
 
+	if (m_pArchetypeStorage)
+		return AddArchetypeSystem(new ArchetypeSystemDynamic<Components...>{ parameters, function });
+
 	TypeBinding* binding{ GetOrCreateBinding<Components...>() };
 	auto system = new BindingSystemDynamic<Components...>{ parameters, function };
 
 	system->SetTypeBinding(binding);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
-		AddDynamicBindingSubSystems(parameters, function);
+		AddDynamicBindingSubSystems<BindingSystemDynamic<Components...>>(parameters, function);
 
 	return system;
 }
@@ -418,16 +687,19 @@ SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters, const
 	// Make sure the name is not in there already
 	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
 
-	auto view = &GetOrCreateView<Component>();
+	if (m_pArchetypeStorage)
+		return AddArchetypeSystem(new ArchetypeSystemDynamicDT<Component>{ parameters, functionDT });
+
+	auto view = &GetOrCreateView<std::remove_const_t<Component>>();
 	auto system = new ViewSystemDynamicDT<Component>{ parameters, functionDT };
 
 	system->SetTypeView(view);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
-		AddDynamicViewSubSystemsDT<Component>(parameters, functionDT);
+		AddDynamicViewSubSystems<ViewSystemDynamicDT<Component>>(parameters, functionDT);
 
 	return system;
 }
@@ -439,32 +711,126 @@ SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters,
 	// Make sure the name is not in there already
 	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
 
+	if (m_pArchetypeStorage)
+		return AddArchetypeSystem(new ArchetypeSystemDynamicDT<Components...>{ parameters, functionDT });
+
 	TypeBinding* binding{ GetOrCreateBinding<Components...>() };
 	auto system = new BindingSystemDynamicDT<Components...>{ parameters, functionDT };
 
 	system->SetTypeBinding(binding);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
-		AddDynamicBindingSubSystems(parameters, functionDT);
+		AddDynamicBindingSubSystems<BindingSystemDynamicDT<Components...>>(parameters, functionDT);
 
 	return system;
 }
 
+template <typename... Components, typename Function>
+SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems) requires SystemCallable<Function, Components...>
+{
+	using Arguments = SystemArguments<Components...>;
+	if constexpr (std::tuple_size_v<typename Arguments::ResourceTypes> > 0)
+	{
+		return AddResourceSystem(parameters, std::forward<Function>(function), AddSubSystems,
+			std::type_identity<typename Arguments::ComponentTypes>{}, std::type_identity<typename Arguments::ResourceTypes>{});
+	}
+	else
+	{
+		return AddCallableSystem<Components...>(parameters, std::forward<Function>(function), AddSubSystems);
+	}
+}
+
+template <typename Function, typename... Components, typename... ResourceTypes>
+SystemBase* EntityRegistry::AddResourceSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems,
+	std::type_identity<std::tuple<Components...>>, std::type_identity<std::tuple<ResourceTypes...>>)
+{
+	// The parameters are copied into the sub systems, so they share the access to the resources
+	SystemParameters resourceParameters{ parameters };
+	(resourceParameters.AddResource<ResourceTypes>(), ...);
+
+	ResourceFunction<std::remove_cvref_t<Function>, ResourceTypes...> resourceFunction{ function, &m_Resources.Get<ResourceTypes>()... };
+	return AddCallableSystem<Components...>(resourceParameters, std::move(resourceFunction), AddSubSystems);
+}
+
+template <typename... Components, typename Function>
+SystemBase* EntityRegistry::AddCallableSystem(const SystemParameters& parameters, Function&& function, bool AddSubSystems)
+{
+	using FunctionType = std::remove_cvref_t<Function>;
+
+	// Make sure the name is not in there already
+	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
+
+	if (m_pArchetypeStorage)
+		return AddArchetypeSystem(new ArchetypeSystemCallable<FunctionType, Components...>{ parameters, function });
+
+	if constexpr (sizeof...(Components) == 1)
+	{
+		using System = ViewSystemCallable<FunctionType, Components...>;
+
+		auto view = &GetOrCreateView<typename System::ComponentType>();
+		auto system = new System{ parameters, function };
+
+		system->SetTypeView(view);
+		system->Initialize();
+
+		EmplaceSystem(system);
+
+		if (AddSubSystems)
+			AddDynamicViewSubSystems<System>(parameters, function);
+
+		return system;
+	}
+	else
+	{
+		using System = BindingSystemCallable<FunctionType, Components...>;
+
+		TypeBinding* binding{ GetOrCreateBinding<Components...>() };
+		auto system = new System{ parameters, function };
+
+		system->SetTypeBinding(binding);
+		system->Initialize();
+
+		EmplaceSystem(system);
+
+		if (AddSubSystems)
+			AddDynamicBindingSubSystems<System>(parameters, function);
+
+		return system;
+	}
+}
+
 template <typename System>	
 SystemBase* EntityRegistry::AddSystem(const SystemParameters& parameters, bool AddSubSystems) requires std::is_base_of_v<SystemBase, System>
 {
 	assert(m_Systems.end() == std::find_if(m_Systems.begin(), m_Systems.end(), [parameters](const std::unique_ptr<SystemBase>& sys) {return sys->GetSystemParameters().name == parameters.name; }));
 
-	if constexpr (isBindingSystem<System>)
+	if constexpr (isArchetypeSystem<System>)
 	{
-		return AddBindingSystem<System>(parameters, AddSubSystems);
+		if (!m_pArchetypeStorage)
+			throw std::runtime_error("Archetype systems can only be added to a registry using StorageMode::Archetypes");
+
+		return AddArchetypeSystem(new System{ parameters });
 	}
 	else
 	{
-		return AddViewSystem<System>(parameters, AddSubSystems);
+		if (m_pArchetypeStorage)
+			throw std::runtime_error("View and Binding systems can not be added to a registry using StorageMode::Archetypes, use an ArchetypeSystem instead");
+
+		if constexpr (isBindingSystem<System>)
+		{
+			return AddBindingSystem<System>(parameters, AddSubSystems);
+		}
+		else if constexpr (std::is_base_of_v<ReactiveSystemBase, System>)
+		{
+			return AddReactiveSystem(new System{ parameters });
+		}
+		else
+		{
+			return AddViewSystem<System>(parameters, AddSubSystems);
+		}
 	}
 }
 
@@ -475,12 +841,48 @@ void EntityRegistry::AddDefaultSystems()
 	AddDefaultSystems(typeId);
 }
 
+template <typename Component>
+SystemBase* EntityRegistry::AddReactiveSystem(const SystemParameters& parameters, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function)
+{
+	return AddReactiveSystem(parameters, reflection::type_id<Component>(), event, function);
+}
+
+template <typename Component>
+ObserverStorage* EntityRegistry::AddObserver(ObserverEvent event)
+{
+	return AddObserver(reflection::type_id<Component>(), event);
+}
+
+template <typename Component> requires Spatial<Component>
+SpatialIndex<Component>* EntityRegistry::AddSpatialIndex(float cellSize)
+{
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Spatial indices can not be added to a registry using StorageMode::Archetypes");
+
+	if (GetSpatialIndex<Component>())
+		throw std::runtime_error("The registry already contains a spatial index of " + std::string(reflection::type_name<Component>()));
+
+	auto index = new SpatialIndex<Component>(&GetOrCreateView<Component>(), cellSize);
+	m_SpatialIndices.emplace_back(index);
+	index->Update();
+	return index;
+}
+
+template <typename Component>
+void EntityRegistry::MarkChanged(entityId id)
+{
+	GetTypeView<Component>().MarkChanged(id);
+}
+
 template <typename Component>
 TypeView<Component>& EntityRegistry::AddView()
 {
+	assert(!m_pArchetypeStorage); // Registries using StorageMode::Archetypes do not have Type Views
+
 	auto view = new TypeView<Component>(this);
 	constexpr uint32_t typeId{ reflection::type_id<Component>() };
 	m_TypeViews.emplace(typeId, view);
+	RegisterView(view);
 
 	// Add default Systems
 	AddDefaultSystems(typeId);
@@ -522,6 +924,13 @@ TypeBinding* EntityRegistry::GetOrCreateBinding()
 	return GetOrCreateBinding(types.data(), types.size());
 }
 
+template <typename ... Types>
+TypeBinding* EntityRegistry::AddGroup()
+{
+	auto types = reflection::Type_ids<Types...>();
+	return AddGroup(types.data(), types.size());
+}
+
 template <typename T>
 Reference<T> EntityRegistry::GetComponent(const Entity& entity)
 {
@@ -535,10 +944,24 @@ Reference<T> EntityRegistry::GetComponent(entityId id)
 	return GetComponent(typeId, id).ToReference<T>();
 }
 
+template <typename Component>
+void EntityRegistry::AddComponents(std::span<const entityId> ids, std::span<const Component> components)
+{
+	if (ids.size() != components.size())
+		throw std::invalid_argument("Every entity needs exactly one Component");
+
+	if (m_pArchetypeStorage)
+		throw std::runtime_error("Components can not be added in bulk to a registry using StorageMode::Archetypes");
+
+	GetOrCreateView<Component>().Add(ids, components);
+}
+
 template <typename T>
 Reference<T> EntityRegistry::AddComponentInstantly(entityId id)
 {
 	constexpr uint32_t typeId = reflection::type_id<T>();
+	if (m_pArchetypeStorage)
+		RegisterArchetypeComponent(ArchetypeComponentInfo::Create<T>());
 	return AddComponentInstantly(typeId, id).ToReference<T>();
 }
 
@@ -551,8 +974,11 @@ Reference<T> EntityRegistry::AddComponentInstantly(const Entity& entity)
 template <typename T>
 T* EntityRegistry::AddComponent(entityId id)
 {
-	constexpr uint32_t typeId = reflection::type_id<T>();
-	return AddComponent(typeId, id);
+	assert(id != Entity::InvalidId);
+
+	// The command keeps a pointer to the info, which is also used to register the Component inside of the Archetype storage
+	static const ArchetypeComponentInfo info{ ArchetypeComponentInfo::Create<T>() };
+	return static_cast<T*>(GetCommandBuffer().AddComponent(id, info));
 }
 
 template <typename T>
@@ -651,97 +1077,36 @@ void EntityRegistry::RemoveComponent(const Entity& entity)
 	RemoveComponent<T>(entity.GetId());
 }
 
-template <typename Component>
-void EntityRegistry::AddDynamicViewSubSystems(const SystemParameters& parameters,
-	const std::function<void(Component&)>& function)
+template <typename System, typename Function>
+void EntityRegistry::AddDynamicViewSubSystems(const SystemParameters& parameters, const Function& function)
 {
-	constexpr uint32_t typeId = reflection::type_id<Component>();
-	const std::vector<uint32_t> subClasses{ TypeInformation::GetSubClasses(typeId) };
-	for (auto subclassId : subClasses)
-	{
-		TypeView<Component>* view = reinterpret_cast<TypeView<Component>*>(GetOrCreateView(subclassId));
-
-		SystemParameters newParams = parameters;
-		newParams.name = parameters.name + "_" + TypeInformation::GetTypeName(subclassId);
-
-		auto system = new ViewSystemDynamic<Component>{ newParams, function };
-
-		system->SetTypeView(view);
-		system->SetFlag(SystemFlags::SubSystem, true);
-		system->Initialize();
-
-		m_Systems.emplace(system);
-	}
-}
-
-template <typename ... Components>
-void EntityRegistry::AddDynamicBindingSubSystems(const SystemParameters& parameters,
-	const std::function<void(Components&...)>& function)
-{
-	// Get The Combinations that can be made using the given components and their child classes
-	constexpr size_t typesAmount{ sizeof...(Components) };
-	constexpr auto typeIds{ reflection::Type_ids<Components...>() };
-	const std::vector<uint32_t> SubClassesCombinations{ TypeInformation::GetSubTypeCombinations(typeIds.data(), typeIds.size()) };
-
-	for (size_t i{}; i < SubClassesCombinations.size(); i += typesAmount)
-	{
-		std::array<uint32_t, typesAmount> subTypeIds;
-
-		std::stringstream sBuffer;
-		sBuffer << parameters.name;
-		for (size_t j{}; j < typesAmount; ++j)
-		{
-			subTypeIds[j] = SubClassesCombinations[i];
-
-			if (j != typesAmount - 1)
-				sBuffer << '_';
-			sBuffer << TypeInformation::GetTypeName(SubClassesCombinations[i]);
-		}
-		SystemParameters newParams = parameters;
-		newParams.name = sBuffer.str();
-
-		auto binding = GetOrCreateBinding(subTypeIds.data(), subTypeIds.size());
-
-		auto subSystem = new BindingSystemDynamic<Components...>{ newParams, function };
-
-		subSystem->SetTypeBinding(binding);
-		subSystem->SetFlag(SystemFlags::SubSystem, true);
-		subSystem->Initialize();
+	using Component = typename System::ComponentType;
 
-		m_Systems.emplace(subSystem);
-	}
-}
-
-template <typename Component>
-void EntityRegistry::AddDynamicViewSubSystemsDT(const SystemParameters& parameters,
-	const std::function<void(float, Component&)>& functionDT)
-{
 	constexpr uint32_t typeId = reflection::type_id<Component>();
 	const std::vector<uint32_t> subClasses{ TypeInformation::GetSubClasses(typeId) };
 	for (auto subclassId : subClasses)
 	{
-		TypeView<Component>* view = reinterpret_cast<TypeView<Component>*>(GetOrCreateView(subclassId));
+		auto view = reinterpret_cast<TypeView<Component>*>(GetOrCreateView(subclassId));
 
 		SystemParameters newParams = parameters;
 		newParams.name = parameters.name + "_" + TypeInformation::GetTypeName(subclassId);
 
-		auto system = new ViewSystemDynamicDT<Component>{ newParams, functionDT };
+		auto system = new System{ newParams, function };
 
 		system->SetTypeView(view);
 		system->SetFlag(SystemFlags::SubSystem, true);
 		system->Initialize();
 
-		m_Systems.emplace(system);
+		EmplaceSystem(system);
 	}
 }
 
-template <typename ... Components>
-void EntityRegistry::AddDynamicBindingSubSystemsDT(const SystemParameters& parameters,
-	const std::function<void(float, Components&...)>& functionDT)
+template <typename System, typename Function>
+void EntityRegistry::AddDynamicBindingSubSystems(const SystemParameters& parameters, const Function& function)
 {
 	// Get The Combinations that can be made using the given components and their child classes
-	constexpr size_t typesAmount{ sizeof...(Components) };
-	constexpr auto typeIds{ reflection::Type_ids<Components...>() };
+	constexpr auto typeIds{ System::GetTypes() };
+	constexpr size_t typesAmount{ typeIds.size() };
 	const std::vector<uint32_t> SubClassesCombinations{ TypeInformation::GetSubTypeCombinations(typeIds.data(), typeIds.size()) };
 
 	for (size_t i{}; i < SubClassesCombinations.size(); i += typesAmount)
@@ -752,24 +1117,24 @@ void EntityRegistry::AddDynamicBindingSubSystemsDT(const SystemParameters& param
 		sBuffer << parameters.name;
 		for (size_t j{}; j < typesAmount; ++j)
 		{
-			subTypeIds[j] = SubClassesCombinations[i];
+			subTypeIds[j] = SubClassesCombinations[i + j];
 
 			if (j != typesAmount - 1)
 				sBuffer << '_';
-			sBuffer << TypeInformation::GetTypeName(SubClassesCombinations[i]);
+			sBuffer << TypeInformation::GetTypeName(SubClassesCombinations[i + j]);
 		}
 		SystemParameters newParams = parameters;
 		newParams.name = sBuffer.str();
 
 		auto binding = GetOrCreateBinding(subTypeIds.data(), subTypeIds.size());
 
-		auto subSystem = new BindingSystemDynamicDT<Components...>{ newParams, functionDT };
+		auto subSystem = new System{ newParams, function };
 
 		subSystem->SetTypeBinding(binding);
 		subSystem->SetFlag(SystemFlags::SubSystem, true);
 		subSystem->Initialize();
 
-		m_Systems.emplace(subSystem);
+		EmplaceSystem(subSystem);
 	}
 }
 
@@ -784,7 +1149,7 @@ SystemBase* EntityRegistry::AddViewSystem(const SystemParameters& parameters, bo
 	system->SetTypeView(view);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
 		AddViewSubSystem<System>(parameters);
@@ -802,7 +1167,7 @@ SystemBase* EntityRegistry::AddBindingSystem(const SystemParameters& parameters,
 	system->SetTypeBinding(binding);
 	system->Initialize();
 
-	m_Systems.emplace(system);
+	EmplaceSystem(system);
 
 	if (AddSubSystems)
 		AddBindingSubSystem<System>(parameters);
@@ -830,7 +1195,7 @@ void EntityRegistry::AddViewSubSystem(const SystemParameters& parameters)
 		system->SetFlag(SystemFlags::SubSystem, true);
 		system->Initialize();
 
-		m_Systems.emplace(system);
+		EmplaceSystem(system);
 	}
 }
 
@@ -850,11 +1215,11 @@ void EntityRegistry::AddBindingSubSystem(const SystemParameters& parameters)
 		sBuffer << parameters.name;
 		for (size_t j{}; j < typesAmount; ++j)
 		{
-			subTypeIds[j] = SubClassesCombinations[i];
+			subTypeIds[j] = SubClassesCombinations[i + j];
 
 			if (j != typesAmount - 1)
 				sBuffer << '_';
-			sBuffer << TypeInformation::GetTypeName(SubClassesCombinations[i]);
+			sBuffer << TypeInformation::GetTypeName(SubClassesCombinations[i + j]);
 		}
 		SystemParameters newParams = parameters;
 		newParams.name = sBuffer.str();
@@ -867,7 +1232,7 @@ void EntityRegistry::AddBindingSubSystem(const SystemParameters& parameters)
 		subSystem->SetFlag(SystemFlags::SubSystem, true);
 		subSystem->Initialize();
 
-		m_Systems.emplace(subSystem);
+		EmplaceSystem(subSystem);
 	}
 }
 
@@ -877,3 +1242,14 @@ TypeBinding* EntityRegistry::AddBinding()
 	auto typeIds = reflection::Type_ids<Types...>();
 	return AddBinding(typeIds.data(), typeIds.size());
 }
+
+template <typename System>
+SystemBase* EntityRegistry::AddArchetypeSystem(System* system)
+{
+	system->SetArchetypeStorage(*m_pArchetypeStorage);
+	system->Initialize();
+
+	EmplaceSystem(system);
+
+	return system;
+}
@@ -0,0 +1,18 @@
+#include "Observer.h"
+
+#include "TypeViewBase.h"
+
+void ObserverStorage::Observe(TypeViewBase* view)
+{
+	auto& callbacks = (m_Event == ObserverEvent::Add) ? view->OnElementAdd : view->OnElementRemove;
+	callbacks.emplace_back([this](TypeViewBase*, entityId id) { Insert(id); });
+
+	if (m_Event == ObserverEvent::Add)
+	{
+		view->OnElementsAdd.emplace_back([this](TypeViewBase*, std::span<const entityId> ids)
+			{
+				for (entityId id : ids)
+					Insert(id);
+			});
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "../Entity/Entity.h"
+#include "../DataAccess/SparseSet.h"
+
+class TypeViewBase;
+
+/** The structural change of a Component an ObserverStorage collects the entities of*/
+enum class ObserverEvent : uint8_t
+{
+	Add,
+	Remove,
+};
+
+/**
+ * Collects the entities a Component was added to or removed from into a dense set without duplicates.
+ * The callbacks of the views only insert the entity, the work reacting to the changes is done in one batch
+ * by the consumer of the storage (see ReactiveSystemBase) instead of during every Add or Remove.
+ * The storage keeps the entities until it is cleared, so an entity may no longer have the Component or may no longer be alive when consumed.
+ */
+class ObserverStorage final
+{
+public:
+
+	ObserverStorage(uint32_t typeId, ObserverEvent event) : m_TypeId(typeId), m_Event(event) {}
+
+	/** The callbacks of the observed views point to the storage*/
+	ObserverStorage(const ObserverStorage&) = delete;
+	ObserverStorage(ObserverStorage&&) = delete;
+	ObserverStorage& operator=(const ObserverStorage&) = delete;
+	ObserverStorage& operator=(ObserverStorage&&) = delete;
+
+public:
+
+	/** Collects the entities of the event of the view, views of sub classes of the Component may be observed by the same storage*/
+	void Observe(TypeViewBase* view);
+
+	void Insert(entityId id)
+	{
+		if (!m_Entities.contains(id))
+			m_Entities.push_back(id);
+	}
+
+	/** The collected entities in the order of their first event*/
+	std::span<const entityId> GetEntities() const { return m_Entities.GetEntities(); }
+
+	bool Contains(entityId id) const { return m_Entities.contains(id); }
+
+	size_t size() const { return m_Entities.size(); }
+	bool empty() const { return m_Entities.empty(); }
+
+	void clear() { m_Entities.clear(); }
+
+	uint32_t GetTypeId() const { return m_TypeId; }
+	ObserverEvent GetEvent() const { return m_Event; }
+
+private:
+
+	SparseSet m_Entities;
+
+	uint32_t m_TypeId;
+	ObserverEvent m_Event;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../TypeInformation/reflection.h"
+
+/**
+ * Template of an entity, a set of Components that is copied to every entity created from it using EntityRegistry::Instantiate.
+ * Instantiating many entities at once grows every view a single time and copies the Component of the prefab into it as one block.
+ * The Components have to be registered using RegisterClass<>, as the views are created using their typeId.
+ */
+class Prefab final
+{
+public:
+
+	struct Entry
+	{
+		uint32_t typeId;
+		void* component;
+		void(*destroy)(void*);
+	};
+
+public:
+
+	Prefab() = default;
+	~Prefab() { clear(); }
+
+	Prefab(const Prefab&) = delete;
+	Prefab& operator=(const Prefab&) = delete;
+
+	Prefab(Prefab&& other) noexcept : m_Components(std::move(other.m_Components)) { other.m_Components.clear(); }
+	Prefab& operator=(Prefab&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			m_Components = std::move(other.m_Components);
+			other.m_Components.clear();
+		}
+		return *this;
+	}
+
+public:
+
+	/** Adds the Component that is copied to the instances, the prefab may not contain the Component yet*/
+	template <typename Component, typename... Arguments>
+	Component& Add(Arguments&&... arguments);
+
+	/** Returns the Component or nullptr if the prefab does not contain it, changes only apply to new instances*/
+	template <typename Component>
+	Component* Find() const;
+
+	template <typename Component>
+	bool Contains() const { return Find<Component>() != nullptr; }
+
+	template <typename Component>
+	void Remove();
+
+	void clear()
+	{
+		for (Entry& entry : m_Components)
+			entry.destroy(entry.component);
+		m_Components.clear();
+	}
+
+	const std::vector<Entry>& GetComponents() const { return m_Components; }
+
+	size_t size() const { return m_Components.size(); }
+	bool empty() const { return m_Components.empty(); }
+
+private:
+
+	std::vector<Entry> m_Components;
+};
+
+template <typename Component, typename... Arguments>
+Component& Prefab::Add(Arguments&&... arguments)
+{
+	static_assert(std::is_copy_constructible_v<Component>, "The Components of a prefab are copied to its instances");
+
+	if (Contains<Component>())
+		throw std::runtime_error("The prefab already contains the Component " + std::string(reflection::type_name<Component>()));
+
+	Component* component{ new Component(std::forward<Arguments>(arguments)...) };
+	m_Components.emplace_back(Entry{ reflection::type_id<Component>(), component, [](void* data) { delete static_cast<Component*>(data); } });
+	return *component;
+}
+
+template <typename Component>
+Component* Prefab::Find() const
+{
+	const uint32_t typeId{ reflection::type_id<Component>() };
+	for (const Entry& entry : m_Components)
+	{
+		if (entry.typeId == typeId)
+			return static_cast<Component*>(entry.component);
+	}
+	return nullptr;
+}
+
+template <typename Component>
+void Prefab::Remove()
+{
+	const uint32_t typeId{ reflection::type_id<Component>() };
+	for (size_t i{}; i < m_Components.size(); ++i)
+	{
+		if (m_Components[i].typeId == typeId)
+		{
+			m_Components[i].destroy(m_Components[i].component);
+			m_Components.erase(m_Components.begin() + i);
+			return;
+		}
+	}
+}
@@ -0,0 +1,378 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "EntityRegistry.h"
+
+/** Components an entity may not have to match a Query*/
+template <typename... Components>
+struct Exclude {};
+
+/** Components that are passed to the function of a Query as a pointer, which is nullptr when the entity does not have the Component*/
+template <typename... Components>
+struct Optional {};
+
+/** Components an entity has to have that changed since the previous iteration of the Query (see TypeViewBase::MarkChanged())*/
+template <typename... Components>
+struct Changed {};
+
+/** Components an entity has to have that were added since the previous iteration of the Query*/
+template <typename... Components>
+struct Added {};
+
+template <typename Include, typename Excluded, typename Optionals, typename ChangedTypes, typename AddedTypes>
+class BasicQuery;
+
+namespace QueryTypes
+{
+	template <typename... Types>
+	struct TypeList {};
+
+	/** Sorts the template arguments of a Query into the included, excluded, optional, changed and added Components*/
+	template <typename Include, typename Excluded, typename Optionals, typename ChangedTypes, typename AddedTypes, typename... Arguments>
+	struct Split;
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>>
+	{
+		using Type = BasicQuery<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>>;
+	};
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A, typename... Types, typename... Arguments>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Exclude<Types...>, Arguments...>
+		: Split<TypeList<I...>, TypeList<E..., Types...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Arguments...> {};
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A, typename... Types, typename... Arguments>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Optional<Types...>, Arguments...>
+		: Split<TypeList<I...>, TypeList<E...>, TypeList<O..., Types...>, TypeList<C...>, TypeList<A...>, Arguments...> {};
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A, typename... Types, typename... Arguments>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Changed<Types...>, Arguments...>
+		: Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C..., Types...>, TypeList<A...>, Arguments...> {};
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A, typename... Types, typename... Arguments>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Added<Types...>, Arguments...>
+		: Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A..., Types...>, Arguments...> {};
+
+	template <typename... I, typename... E, typename... O, typename... C, typename... A, typename Type, typename... Arguments>
+	struct Split<TypeList<I...>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Type, Arguments...>
+		: Split<TypeList<I..., Type>, TypeList<E...>, TypeList<O...>, TypeList<C...>, TypeList<A...>, Arguments...> {};
+}
+
+/**
+ * Iterates the entities that have all the included Components and none of the excluded Components, without storing anything between iterations.
+ * The view of the included Component with the fewest enabled elements is iterated and every entity is filtered using its Component signature,
+ * so unlike a TypeBinding a query does not have to be kept up to date whenever Components are added or removed.
+ * Use a TypeBinding for joins that are iterated every frame and a Query for joins that are only needed occasionally.
+ *
+ * Only enabled Components are passed to the function, an entity with a disabled included Component is skipped.
+ * An entity with a disabled excluded Component still counts as having the Component.
+ * Entities and Components may only be added or removed while iterating using the deferred functions of the registry.
+ *
+ * The changed and added Components filter the entities on the change ticks of their Components, they are not passed to the function.
+ * A query with these filters remembers the tick of its previous iteration and only visits the entities whose Components were changed
+ * or added after it. The view of the first filter is iterated in chunks, so chunks without a newer tick are skipped using a single comparison.
+ * Changes made during the iteration count as seen by the query.
+ */
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+class BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>
+{
+	using Tick = ChangeTicks::Tick;
+
+	constexpr static bool HasTickFilter{ sizeof...(ChangedTypes) + sizeof...(AddedTypes) > 0 };
+
+	static_assert(sizeof...(Include) + sizeof...(ChangedTypes) + sizeof...(AddedTypes) >= 1, "A Query needs at least one included Component");
+
+public:
+
+	/** Creates the views of all the Components that do not exist yet*/
+	BasicQuery(EntityRegistry& registry);
+
+	/**
+	 * Calls the function with references to the included Components followed by pointers to the optional Components of every matching entity.
+	 * The function may take the entityId as first parameter.
+	 */
+	template <typename Function>
+	void ForEach(Function&& function);
+
+	/** Returns true if the entity matches the query*/
+	bool Matches(entityId id) const;
+
+	/** Amount of entities that match the query, this iterates the query and so advances the last tick of a query with tick filters*/
+	size_t GetEntityAmount();
+
+	/** The tick of the previous iteration, only Components changed or added after it pass the tick filters*/
+	Tick GetLastTick() const { return m_LastTick; }
+
+private:
+
+	/** Visits the entities of the enabled Components of the view that were added or changed after the last tick, chunk by chunk*/
+	template <typename Function, typename Component>
+	void ForEachNewer(Function& function, const TypeView<Component>* view, bool added);
+
+	/** Visits the entity if it matches the query*/
+	template <typename Function>
+	void Visit(Function& function, entityId id);
+
+	/** Returns the included view with the fewest enabled elements and its amount of enabled elements*/
+	std::pair<const TypeViewBase*, size_t> GetSmallestView() const;
+
+	bool MatchesSignature(entityId id) const;
+
+	/** Returns true if all the changed and added Components of the entity are enabled and newer than the last tick*/
+	bool MatchesTicks(entityId id) const;
+
+	template <typename Component>
+	bool IsNewer(const TypeView<Component>* view, entityId id, bool added) const;
+
+	/** Fills in the positions of the included Components, returns false when one of them is not enabled*/
+	template <size_t... Indices>
+	bool FindIncluded(entityId id, std::array<size_t, sizeof...(Include)>& positions, std::index_sequence<Indices...>) const;
+
+	template <typename Component>
+	static Component* FindOptional(TypeView<Component>* view, entityId id);
+
+	/** Returns the Component at the position of the view, every position of the view of a tag is the shared tag*/
+	template <typename Component>
+	static Component& At(TypeView<Component>* view, size_t position);
+
+	template <typename Function, size_t... Indices, size_t... OptionalIndices>
+	void Apply(Function& function, entityId id, const std::array<size_t, sizeof...(Include)>& positions,
+		std::index_sequence<Indices...>, std::index_sequence<OptionalIndices...>);
+
+private:
+
+	EntityRegistry* m_pRegistry{};
+	const ComponentSignatures* m_pSignatures{};
+
+	std::tuple<TypeView<Include>*...> m_IncludeViews;
+	std::tuple<TypeView<Optionals>*...> m_OptionalViews;
+	std::tuple<TypeView<ChangedTypes>*...> m_ChangedViews;
+	std::tuple<TypeView<AddedTypes>*...> m_AddedViews;
+
+	Tick m_LastTick{};
+
+	/** The bits of the views of the included (including the changed and added) and excluded Components inside of the Component signatures*/
+	std::vector<uint64_t> m_IncludeMask;
+	std::vector<uint64_t> m_ExcludeMask;
+};
+
+/**
+ * Query<Include..., Exclude<Excluded...>, Optional<Optionals...>> iterates the entities with all the included and none of the excluded Components.
+ * Exclude<>, Optional<>, Changed<> and Added<> may be used in any position and any amount of Components is supported, see BasicQuery.
+ */
+template <typename... Arguments>
+class Query final : public QueryTypes::Split<QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, Arguments...>::Type
+{
+	using Base = typename QueryTypes::Split<QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, QueryTypes::TypeList<>, Arguments...>::Type;
+
+public:
+	using Base::Base;
+};
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::BasicQuery(EntityRegistry& registry)
+	: m_pRegistry(&registry)
+	, m_pSignatures(&registry.GetSignatures())
+	, m_IncludeViews(&registry.GetOrCreateView<Include>()...)
+	, m_OptionalViews(&registry.GetOrCreateView<Optionals>()...)
+	, m_ChangedViews(&registry.GetOrCreateView<ChangedTypes>()...)
+	, m_AddedViews(&registry.GetOrCreateView<AddedTypes>()...)
+{
+	assert(!registry.GetArchetypeStorage()); // Registries using StorageMode::Archetypes have to use an ArchetypeQuery
+
+	auto setIncluded = [this](const auto*... views) { (ComponentSignatures::SetMaskBit(m_IncludeMask, views->GetViewIndex()), ...); };
+	std::apply(setIncluded, m_IncludeViews);
+	std::apply(setIncluded, m_ChangedViews);
+	std::apply(setIncluded, m_AddedViews);
+	(ComponentSignatures::SetMaskBit(m_ExcludeMask, registry.GetOrCreateView<Excluded>().GetViewIndex()), ...);
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Function>
+void BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::ForEach(Function&& function)
+{
+	if constexpr (HasTickFilter)
+	{
+		// Iterate the view of the first tick filter, the other filters are checked per entity
+		if constexpr (sizeof...(ChangedTypes) > 0)
+			ForEachNewer(function, std::get<0>(m_ChangedViews), false);
+		else
+			ForEachNewer(function, std::get<0>(m_AddedViews), true);
+
+		// Everything up to and including the current tick has been seen, including the changes made by the function
+		m_LastTick = m_pRegistry->AdvanceChangeTick();
+	}
+	else
+	{
+		const auto [view, activeAmount] { GetSmallestView() };
+
+		// The entities of the inactive elements are at the back of the view
+		const std::span<const entityId> entities{ view->GetRegisteredEntities() };
+		for (size_t i{}; i < activeAmount; ++i)
+			Visit(function, entities[i]);
+	}
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Function, typename Component>
+void BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::ForEachNewer(Function& function, const TypeView<Component>* view, bool added)
+{
+	const ChangeTicks& changeTicks{ view->GetChangeTicks() };
+	const Tick* ticks{ added ? changeTicks.GetAddedTicks() : changeTicks.GetChangedTicks() };
+	const std::span<const entityId> entities{ view->GetRegisteredEntities() };
+	const size_t activeAmount{ view->GetActiveAmount() };
+
+	const size_t chunkAmount{ ChangeTicks::GetChunkAmount(activeAmount) };
+	for (size_t chunk{}; chunk < chunkAmount; ++chunk)
+	{
+		const Tick chunkTick{ added ? changeTicks.GetChunkAdded(chunk) : changeTicks.GetChunkChanged(chunk) };
+		if (chunkTick <= m_LastTick)
+			continue;
+
+		const size_t end{ std::min((chunk + 1) * ChangeTicks::ChunkSize, activeAmount) };
+		for (size_t i{ chunk * ChangeTicks::ChunkSize }; i < end; ++i)
+		{
+			if (ticks[i] > m_LastTick)
+				Visit(function, entities[i]);
+		}
+	}
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Function>
+void BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::Visit(Function& function, entityId id)
+{
+	std::array<size_t, sizeof...(Include)> positions;
+	if (!MatchesSignature(id) || !FindIncluded(id, positions, std::index_sequence_for<Include...>{}))
+		return;
+
+	if constexpr (HasTickFilter)
+	{
+		if (!MatchesTicks(id))
+			return;
+	}
+
+	Apply(function, id, positions, std::index_sequence_for<Include...>{}, std::index_sequence_for<Optionals...>{});
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+bool BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::Matches(entityId id) const
+{
+	std::array<size_t, sizeof...(Include)> positions;
+	return MatchesSignature(id) && FindIncluded(id, positions, std::index_sequence_for<Include...>{}) && MatchesTicks(id);
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+size_t BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::GetEntityAmount()
+{
+	size_t amount{};
+	ForEach([&amount](Include&..., Optionals*...) { ++amount; });
+	return amount;
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+std::pair<const TypeViewBase*, size_t> BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::GetSmallestView() const
+{
+	const TypeViewBase* smallest{};
+	size_t amount{ std::numeric_limits<size_t>::max() };
+
+	auto compare = [&smallest, &amount](const auto* view)
+	{
+		if (view->GetActiveAmount() < amount)
+		{
+			smallest = view;
+			amount = view->GetActiveAmount();
+		}
+	};
+	std::apply([&compare](const auto*... views) { (compare(views), ...); }, m_IncludeViews);
+
+	return { smallest, amount };
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+bool BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::MatchesSignature(entityId id) const
+{
+	if (!m_pSignatures->ContainsAll(id, m_IncludeMask))
+		return false;
+
+	if constexpr (sizeof...(Excluded) > 0)
+	{
+		if (!m_pSignatures->ContainsNone(id, m_ExcludeMask))
+			return false;
+	}
+	return true;
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+bool BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::MatchesTicks(entityId id) const
+{
+	return std::apply([this, id](const auto*... views) { return (IsNewer(views, id, false) && ...); }, m_ChangedViews)
+		&& std::apply([this, id](const auto*... views) { return (IsNewer(views, id, true) && ...); }, m_AddedViews);
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Component>
+bool BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::IsNewer(const TypeView<Component>* view, entityId id, bool added) const
+{
+	const size_t position{ view->GetPosition(id) };
+	if (position >= view->GetActiveAmount())
+		return false;
+
+	const ChangeTicks& ticks{ view->GetChangeTicks() };
+	return (added ? ticks.GetAdded(position) : ticks.GetChanged(position)) > m_LastTick;
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <size_t... Indices>
+bool BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::FindIncluded(entityId id,
+	std::array<size_t, sizeof...(Include)>& positions, std::index_sequence<Indices...>) const
+{
+	// The position of a missing Component is SparseSet::InvalidPos, which is never smaller than the active amount
+	return ((positions[Indices] = std::get<Indices>(m_IncludeViews)->GetPosition(id),
+		positions[Indices] < std::get<Indices>(m_IncludeViews)->GetActiveAmount()) && ...);
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Component>
+Component* BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::FindOptional(TypeView<Component>* view, entityId id)
+{
+	const size_t position{ view->GetPosition(id) };
+	return (position < view->GetActiveAmount()) ? &At(view, position) : nullptr;
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Component>
+Component& BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::At(TypeView<Component>* view, size_t position)
+{
+	if constexpr (std::is_empty_v<Component>)
+		return *view->GetData();
+	else
+		return view->GetData()[position];
+}
+
+template <typename... Include, typename... Excluded, typename... Optionals, typename... ChangedTypes, typename... AddedTypes>
+template <typename Function, size_t... Indices, size_t... OptionalIndices>
+void BasicQuery<QueryTypes::TypeList<Include...>, QueryTypes::TypeList<Excluded...>, QueryTypes::TypeList<Optionals...>, QueryTypes::TypeList<ChangedTypes...>, QueryTypes::TypeList<AddedTypes...>>::Apply(Function& function, entityId id,
+	const std::array<size_t, sizeof...(Include)>& positions, std::index_sequence<Indices...>, std::index_sequence<OptionalIndices...>)
+{
+	if constexpr (std::is_invocable_v<Function&, Include&..., Optionals*...>)
+	{
+		function(At(std::get<Indices>(m_IncludeViews), positions[Indices])...,
+			FindOptional(std::get<OptionalIndices>(m_OptionalViews), id)...);
+	}
+	else
+	{
+		function(id, At(std::get<Indices>(m_IncludeViews), positions[Indices])...,
+			FindOptional(std::get<OptionalIndices>(m_OptionalViews), id)...);
+	}
+}
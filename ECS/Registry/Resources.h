@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../TypeInformation/reflection.h"
+
+/**
+ * Marks a template argument of a dynamic system as a resource of the registry instead of a Component.
+ * The resource is passed to the function after the Components, a const resource is only read by the system.
+ */
+template <typename T>
+struct Resource {};
+
+/**
+ * Stores a single instance of every type of resource (global state like the camera, input or time) of a registry.
+ * Every type gets a dense index the first time it is used, so finding a resource is a single array lookup.
+ * The resources are allocated separately and never move, so pointers to them stay valid until they are removed.
+ */
+class ResourceStorage final
+{
+public:
+
+	ResourceStorage() = default;
+	~ResourceStorage() { clear(); }
+
+	ResourceStorage(const ResourceStorage&) = delete;
+	ResourceStorage(ResourceStorage&&) = delete;
+	ResourceStorage& operator=(const ResourceStorage&) = delete;
+	ResourceStorage& operator=(ResourceStorage&&) = delete;
+
+public:
+
+	/** Constructs the resource using the arguments, the resource may not exist yet*/
+	template <typename T, typename... Arguments>
+	T& Add(Arguments&&... arguments);
+
+	/** Returns the resource or nullptr if it does not exist*/
+	template <typename T>
+	T* Find() const;
+
+	/** Returns the resource, throws if it does not exist*/
+	template <typename T>
+	T& Get() const;
+
+	template <typename T>
+	bool Contains() const { return Find<T>() != nullptr; }
+
+	template <typename T>
+	void Remove();
+
+	void clear();
+
+	/** The dense index of the type, shared by all storages*/
+	template <typename T>
+	static size_t GetIndex();
+
+private:
+
+	struct Entry
+	{
+		void* data;
+		void(*destroy)(void*);
+	};
+
+	std::vector<Entry> m_Resources;
+
+	inline static std::atomic<size_t> s_IndexCounter{};
+};
+
+/**
+ * Function object of a dynamic system that passes the resources after the arguments it is called with.
+ * The resources are found once when the system is added, as resources never move.
+ */
+template <typename Function, typename... Resources>
+class ResourceFunction final
+{
+public:
+
+	ResourceFunction(const Function& function, Resources*... resources) : m_Function(function), m_Resources(resources...) {}
+
+	template <typename... Arguments> requires std::is_invocable_v<Function&, Arguments..., Resources&...>
+	void operator()(Arguments&&... arguments)
+	{
+		std::apply([this, &arguments...](Resources*... resources) { m_Function(std::forward<Arguments>(arguments)..., *resources...); }, m_Resources);
+	}
+
+private:
+
+	Function m_Function;
+	std::tuple<Resources*...> m_Resources;
+};
+
+template <typename T, typename... Arguments>
+T& ResourceStorage::Add(Arguments&&... arguments)
+{
+	static_assert(!std::is_const_v<T>);
+
+	const size_t index{ GetIndex<T>() };
+	if (index >= m_Resources.size())
+		m_Resources.resize(index + 1, Entry{ nullptr, nullptr });
+
+	if (m_Resources[index].data)
+		throw std::runtime_error("The registry already contains the resource " + std::string(reflection::type_name<T>()));
+
+	T* resource{ new T(std::forward<Arguments>(arguments)...) };
+	m_Resources[index] = Entry{ resource, [](void* data) { delete static_cast<T*>(data); } };
+	return *resource;
+}
+
+template <typename T>
+T* ResourceStorage::Find() const
+{
+	const size_t index{ GetIndex<std::remove_const_t<T>>() };
+	return (index < m_Resources.size()) ? static_cast<T*>(m_Resources[index].data) : nullptr;
+}
+
+template <typename T>
+T& ResourceStorage::Get() const
+{
+	T* resource{ Find<T>() };
+	if (!resource)
+		throw std::runtime_error("The registry does not contain the resource " + std::string(reflection::type_name<std::remove_const_t<T>>()));
+	return *resource;
+}
+
+template <typename T>
+void ResourceStorage::Remove()
+{
+	const size_t index{ GetIndex<std::remove_const_t<T>>() };
+	if (index < m_Resources.size() && m_Resources[index].data)
+	{
+		m_Resources[index].destroy(m_Resources[index].data);
+		m_Resources[index] = Entry{ nullptr, nullptr };
+	}
+}
+
+inline void ResourceStorage::clear()
+{
+	for (Entry& entry : m_Resources)
+	{
+		if (entry.data)
+			entry.destroy(entry.data);
+	}
+	m_Resources.clear();
+}
+
+template <typename T>
+size_t ResourceStorage::GetIndex()
+{
+	static const size_t index{ s_IndexCounter.fetch_add(1, std::memory_order_relaxed) };
+	return index;
+}
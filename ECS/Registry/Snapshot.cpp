@@ -0,0 +1,50 @@
+#include "EntityRegistry.h"
+#include "Snapshot.h"
+
+#include <cassert>
+#include <stdexcept>
+
+SnapshotHistory::SnapshotHistory(size_t capacity)
+	: m_Snapshots(capacity)
+{
+	assert(capacity > 0);
+	m_Latest = capacity - 1;
+}
+
+void SnapshotHistory::Save(EntityRegistry& registry)
+{
+	const RegistrySnapshot* previous{ m_Size ? &m_Snapshots[m_Latest] : nullptr };
+
+	m_Latest = (m_Latest + 1) % m_Snapshots.size();
+	registry.TakeSnapshot(m_Snapshots[m_Latest], previous);
+
+	if (m_Size < m_Snapshots.size())
+		++m_Size;
+}
+
+void SnapshotHistory::Rollback(EntityRegistry& registry, size_t frames)
+{
+	if (frames >= m_Size)
+		throw std::out_of_range("The snapshot history only contains " + std::to_string(m_Size) + " snapshots");
+
+	m_Latest = GetSlot(frames);
+	m_Size -= frames;
+	registry.RestoreSnapshot(m_Snapshots[m_Latest]);
+}
+
+const RegistrySnapshot& SnapshotHistory::Get(size_t frames) const
+{
+	if (frames >= m_Size)
+		throw std::out_of_range("The snapshot history only contains " + std::to_string(m_Size) + " snapshots");
+
+	return m_Snapshots[GetSlot(frames)];
+}
+
+void SnapshotHistory::clear()
+{
+	for (RegistrySnapshot& snapshot : m_Snapshots)
+		snapshot.clear();
+
+	m_Latest = m_Snapshots.size() - 1;
+	m_Size = 0;
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "../Entity/EntityPool.h"
+#include "../DataAccess/ChangeTicks.h"
+#include "TypeViewBase.h"
+
+class EntityRegistry;
+
+/**
+ * Copy of the entities and Components of a registry, used to roll the registry back to an earlier frame (see EntityRegistry::TakeSnapshot).
+ * Every view is stored as a shared ViewSnapshot, a snapshot taken with a previous snapshot shares the views that did not change since then,
+ * so an unchanged view costs neither a copy nor memory. Components that were written to outside of systems have to be marked using MarkChanged to be copied again.
+ * Resources, systems, observers and the commands that were not played back yet are not part of a snapshot.
+ */
+class RegistrySnapshot final
+{
+	friend class EntityRegistry;
+
+public:
+
+	/** Returns true if the snapshot was taken and not cleared*/
+	bool IsValid() const { return m_Tick != 0; }
+
+	/** The change tick of the registry at the time the snapshot was taken, Components marked after it are newer*/
+	ChangeTicks::Tick GetTick() const { return m_Tick; }
+
+	/** The snapshots of the views, indexed by the view index. Snapshots shared with other snapshots point to the same ViewSnapshot*/
+	const std::vector<std::shared_ptr<ViewSnapshot>>& GetViews() const { return m_Views; }
+
+	/** Releases the memory of the snapshot*/
+	void clear()
+	{
+		m_Entities.reset();
+		m_Views.clear();
+		m_Bindings.clear();
+		m_Tick = 0;
+	}
+
+private:
+
+	/** The entities of the elements of a binding in the order in which they are iterated*/
+	struct BindingSnapshot
+	{
+		std::vector<entityId> entities;
+		uint32_t version{};
+	};
+
+	/** Replaces a snapshot that is still shared with a different snapshot by a new one, so it can be overwritten*/
+	template <typename T>
+	static T& MakeUnique(std::shared_ptr<T>& snapshot)
+	{
+		if (!snapshot || snapshot.use_count() > 1)
+			snapshot = std::make_shared<T>();
+		return *snapshot;
+	}
+
+private:
+
+	std::shared_ptr<EntityPool> m_Entities;
+	std::vector<std::shared_ptr<ViewSnapshot>> m_Views;
+
+	/** The snapshots of the bindings, in the order of the bindings of the registry*/
+	std::vector<std::shared_ptr<BindingSnapshot>> m_Bindings;
+
+	ChangeTicks::Tick m_Tick{};
+};
+
+/**
+ * Ring of the snapshots of the last frames, used for client-side prediction: save every frame and roll back when the server disagrees.
+ * Every snapshot is taken with the one before it as previous, so only the views that changed during a frame are copied.
+ * The memory of the oldest snapshot is reused for the newest one, so saving does not allocate once the ring is full and the views stopped growing.
+ */
+class SnapshotHistory final
+{
+public:
+
+	explicit SnapshotHistory(size_t capacity);
+
+public:
+
+	/** Takes a snapshot of the registry, replacing the oldest snapshot when the history is full*/
+	void Save(EntityRegistry& registry);
+
+	/**
+	 * Restores the registry to the snapshot that was saved frames saves ago, 0 being the latest.
+	 * The newer snapshots are discarded, so the restored snapshot becomes the latest.
+	 * @throws std::out_of_range: when the history contains frames snapshots or less
+	 */
+	void Rollback(EntityRegistry& registry, size_t frames);
+
+	/** Returns the snapshot that was saved frames saves ago, 0 being the latest*/
+	const RegistrySnapshot& Get(size_t frames) const;
+
+	size_t size() const { return m_Size; }
+	size_t capacity() const { return m_Snapshots.size(); }
+	bool empty() const { return m_Size == 0; }
+
+	void clear();
+
+private:
+
+	size_t GetSlot(size_t frames) const { return (m_Latest + m_Snapshots.size() - frames) % m_Snapshots.size(); }
+
+private:
+
+	std::vector<RegistrySnapshot> m_Snapshots;
+
+	/** The slot of the latest snapshot*/
+	size_t m_Latest{};
+	size_t m_Size{};
+};
@@ -0,0 +1,30 @@
+#include "EntityRegistry.h"
+#include "SpatialIndex.h"
+
+SpatialIndexBase::SpatialIndexBase(TypeViewBase* pView, float cellSize)
+	: m_pView(pView)
+	, m_Grid(cellSize)
+{
+	// Removed, enabled and disabled Components do not change the ticks of the view
+	auto markDirty = [this](TypeViewBase*, entityId) { m_IsDirty = true; };
+	m_pView->OnElementRemove.emplace_back(markDirty);
+	m_pView->OnElementDisable.emplace_back(markDirty);
+	m_pView->OnElementEnable.emplace_back(markDirty);
+}
+
+void SpatialIndexBase::Update()
+{
+	// Added Components count as changed at the tick they were added
+	const ChangeTicks& ticks{ m_pView->GetChangeTicks() };
+	const size_t chunks{ ChangeTicks::GetChunkAmount(ticks.size()) };
+	for (size_t chunk{}; chunk < chunks && !m_IsDirty; ++chunk)
+		m_IsDirty = ticks.GetChunkChanged(chunk) > m_BuildTick;
+
+	if (!m_IsDirty)
+		return;
+
+	// Changes made from now on have a higher tick than the build
+	m_BuildTick = m_pView->GetRegistry()->AdvanceChangeTick();
+	Rebuild();
+	m_IsDirty = false;
+}
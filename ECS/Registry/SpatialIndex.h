@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+
+#include "../DataAccess/SpatialGrid.h"
+#include "../DataAccess/ChangeTicks.h"
+#include "../TypeInformation/Concepts.h"
+#include "TypeView.h"
+
+/**
+ * Keeps a SpatialGrid of the positions of the enabled Components of a view.
+ * The grid is rebuilt by Update when Components were added, changed, removed, enabled or disabled since the previous build.
+ * Changes are found using the change ticks of the view, so Components that moved outside of systems have to be marked using MarkChanged.
+ * The grid is only read between updates, so systems executing in parallel may query it at the same time.
+ */
+class SpatialIndexBase
+{
+public:
+
+	SpatialIndexBase(TypeViewBase* pView, float cellSize);
+	virtual ~SpatialIndexBase() = default;
+
+	/** The callbacks of the view point to the index*/
+	SpatialIndexBase(const SpatialIndexBase&) = delete;
+	SpatialIndexBase(SpatialIndexBase&&) = delete;
+	SpatialIndexBase& operator=(const SpatialIndexBase&) = delete;
+	SpatialIndexBase& operator=(SpatialIndexBase&&) = delete;
+
+public:
+
+	/** Rebuilds the grid if the Components changed since the previous build, advances the change tick of the registry when it does*/
+	void Update();
+
+	/** Rebuilds the grid at the next Update, for changes that were not marked*/
+	void MarkDirty() { m_IsDirty = true; }
+
+	const SpatialGrid& GetGrid() const { return m_Grid; }
+
+	uint32_t GetTypeId() const { return m_pView->GetTypeId(); }
+
+protected:
+
+	/** Fills the grid with the positions of the enabled Components*/
+	virtual void Rebuild() = 0;
+
+protected:
+
+	TypeViewBase* m_pView;
+	SpatialGrid m_Grid;
+
+private:
+
+	ChangeTicks::Tick m_BuildTick{};
+	bool m_IsDirty{ true };
+};
+
+template <typename Component> requires Spatial<Component>
+class SpatialIndex final : public SpatialIndexBase
+{
+public:
+
+	SpatialIndex(TypeView<Component>* pView, float cellSize) : SpatialIndexBase(pView, cellSize), m_pTypeView(pView) {}
+	~SpatialIndex() override = default;
+
+private:
+
+	void Rebuild() override;
+
+private:
+
+	TypeView<Component>* m_pTypeView;
+};
+
+template <typename Component> requires Spatial<Component>
+void SpatialIndex<Component>::Rebuild()
+{
+	// The enabled Components are at the front of the data array
+	const Component* pData{ static_cast<const Component*>(static_cast<TypeViewBase*>(m_pTypeView)->GetVoidData()) };
+	const entityId* pEntities{ m_pTypeView->GetRegisteredEntities().data() };
+
+	m_Grid.Build(m_pTypeView->GetActiveAmount(), [pData, pEntities](size_t i)
+		{
+			const auto position{ SpatialPosition(pData[i]) };
+			return SpatialGrid::Element{ float(position.x), float(position.y), pEntities[i] };
+		});
+}
@@ -0,0 +1,464 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "TypeView.h"
+
+/**
+ * TypeView of an empty Component (a tag like Selected or Dead), only storing which entities have the tag.
+ * There is no data array and no reference pool: every entity shares the same instance of the tag and the same ReferencePointer,
+ * so a Reference to a tag stays valid after the tag is removed from the entity.
+ * GetVoidData() returns the shared instance and GetElementSize() is 0, so TypeBindings and Queries resolve every position to that instance.
+ */
+template <typename Component> requires std::is_empty_v<Component>
+class TypeView<Component> : public TypeViewBase
+{
+public:
+
+	using ComponentType = Component;
+
+	/** Iterates the positions of the view, every position points to the shared instance*/
+	class Iterator final
+	{
+	public:
+		Iterator(Component* tag, size_t pos) : m_pTag(tag), m_Pos(pos) {}
+
+		Component& operator*() const { return *m_pTag; }
+		Component* operator->() const { return m_pTag; }
+
+		Iterator& operator++() { ++m_Pos; return *this; }
+		Iterator operator++(int) { Iterator it{ *this }; ++m_Pos; return it; }
+		Iterator operator+(size_t offset) const { return Iterator{ m_pTag, m_Pos + offset }; }
+		Iterator operator-(size_t offset) const { return Iterator{ m_pTag, m_Pos - offset }; }
+
+		bool operator==(const Iterator& other) const { return m_Pos == other.m_Pos; }
+		bool operator!=(const Iterator& other) const { return m_Pos != other.m_Pos; }
+
+	private:
+		Component* m_pTag;
+		size_t m_Pos;
+	};
+
+public:
+
+	TypeView(EntityRegistry* pRegistry) : TypeViewBase(pRegistry) {}
+	~TypeView() override = default;
+
+	TypeView(const TypeView&) = delete;
+	TypeView(TypeView&&) = delete;
+	TypeView& operator=(const TypeView&) = delete;
+	TypeView& operator=(TypeView&&) = delete;
+
+public:
+
+	void Update(float deltaTime) override;
+
+	/** The tag is shared by all entities, so the entity can not be found using its address*/
+	entityId GetEntityId(const void* elementAddress) override;
+
+	Reference<Component> Get(entityId id) const;
+
+	VoidReference GetVoidReference(entityId id) const override;
+
+	Reference<Component> Add(entityId id, const Component&) { return Add(id); }
+	Reference<Component> Add(entityId id, Component&&) { return Add(id); }
+	Reference<Component> Add(entityId id);
+	Reference<Component> Add(Entity entity) { return Add(entity.GetId()); }
+	void Add(std::span<const entityId> ids, std::span<const Component>) { AddEntities(ids.data(), ids.size(), nullptr); }
+
+	Component* AddAfterUpdate(entityId id);
+	Component* AddAfterUpdate(Entity entity) { return AddAfterUpdate(entity.GetId()); }
+
+	void Remove(entityId id) override;
+
+	size_t GetSize() const { return m_EntitySet.size(); }
+	size_t GetActiveAmount() const { return GetSize() - m_InactiveItems; }
+	size_t GetInactiveAmount() const { return m_InactiveItems; }
+
+	/** Returns the shared instance of the tag*/
+	const Component* GetData() const { return &m_Tag; }
+	Component* GetData() { return &m_Tag; }
+
+	size_t GetElementSize() const override { return 0; }
+
+	Iterator begin() { return Iterator{ &m_Tag, 0 }; }
+	Iterator end() { return Iterator{ &m_Tag, GetActiveAmount() }; }
+	Iterator beginInactives() { return end(); }
+	Iterator endInactive() { return Iterator{ &m_Tag, GetSize() }; }
+
+	void SetInactive(entityId id);
+	void SetActive(entityId id);
+	bool IsActive(entityId id) const { return GetPositionInArray(id) < GetActiveAmount(); }
+
+	uint32_t GetTypeId() const override { return typeId; }
+
+	void SerializeView(std::ostream& stream) override;
+	void DeserializeView(std::istream& stream) override;
+	void PrintType(std::ostream& stream) override { stream << '[' << reflection::type_name<Component>() << ']'; }
+	TypeViewInfo GetInfo() override;
+	void UpdateInfo(TypeViewInfo& info) override;
+
+	void TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick) override;
+	void RestoreSnapshot(const ViewSnapshot* snapshot) override;
+	void RestoreData(const ViewSnapshot&) override {}
+
+	VoidReference AddEntity(entityId id) override { return VoidReference(static_cast<void*>(&Add(id).GetReferencePointer())); }
+	VoidReference AddEntity(entityId id, void*) override { return AddEntity(id); }
+	void AddEntities(const entityId* ids, size_t amount, const void* component) override;
+	void MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds) override;
+	void* AddAfterUpdate_void(entityId id) override { return AddAfterUpdate(id); }
+
+	/** The tag is shared by all entities, so it can only be enabled and disabled through the entity*/
+	void Enable(const VoidReference& ref) override;
+	void Enable(entityId id) override { SetActive(id); }
+	void Disable(const VoidReference& ref) override;
+	void Disable(entityId id) override { SetInactive(id); }
+	bool IsEnabled(const VoidReference& ref) const override;
+	bool IsEnabled(entityId id) const override { return IsActive(id); }
+
+	/** Tags have no order*/
+	void SortData() override {}
+
+	size_t GetPositionInArray(entityId id) const
+	{
+		assert(Contains(id));
+		return m_EntitySet.Find(id);
+	}
+
+private:
+
+	VoidIterator GetVoidIterator() override { return VoidIterator(static_cast<void*>(&m_Tag), 0); }
+	VoidIterator GetVoidIteratorEnd() override { return VoidIterator(static_cast<void*>(&m_Tag), 0); }
+
+	void* GetVoidData() override { return &m_Tag; }
+
+	/** Adds the entity at the back and moves it in front of the inactive entities*/
+	void AddMap(entityId id);
+
+	/** Removes the entity at the position while keeping the inactive entities at the back*/
+	void SwapRemove(size_t pos);
+
+	void SwapPositions(size_t pos0, size_t pos1);
+
+	void SwapElements(size_t pos0, size_t pos1) override { SwapPositions(pos0, pos1); }
+
+private:
+
+	Component m_Tag{};
+
+	/** Shared by the References to the tag of every entity*/
+	mutable ReferencePointer<Component> m_Reference{ &m_Tag };
+
+	size_t m_InactiveItems{};
+
+	std::vector<entityId> m_AddedEntitiesUpdate;
+
+	const uint32_t typeId{ reflection::type_id<Component>() };
+
+};
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::Update(float)
+{
+	for (entityId id : m_AddedEntitiesUpdate)
+	{
+		if (!Contains(id))
+			Add(id);
+	}
+	m_AddedEntitiesUpdate.clear();
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+entityId TypeView<Component>::GetEntityId(const void*)
+{
+	throw std::runtime_error("The entity of a tag can not be found using its address, tags are shared by all entities");
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+Reference<Component> TypeView<Component>::Get(entityId id) const
+{
+	if (Contains(id))
+		return Reference<Component>(m_Reference);
+	return Reference<Component>::InvalidRef();
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+VoidReference TypeView<Component>::GetVoidReference(entityId id) const
+{
+	if (Contains(id))
+		return VoidReference(static_cast<void*>(&m_Reference));
+	return VoidReference(nullptr);
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+Reference<Component> TypeView<Component>::Add(entityId id)
+{
+	assert(!Contains(id));
+
+	AddMap(id);
+	for (auto& callback : OnElementAdd)
+		callback(this, id);
+
+	if constexpr (Initializable<Component>)
+	{
+		m_Tag.Initialize(GetRegistry());
+	}
+
+	return Reference<Component>(m_Reference);
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::AddEntities(const entityId* ids, size_t amount, const void*)
+{
+	m_EntitySet.reserve(GetSize() + amount);
+	m_Ticks.reserve(GetSize() + amount);
+
+	for (size_t i{}; i < amount; ++i)
+	{
+		assert(!Contains(ids[i]));
+		AddMap(ids[i]);
+	}
+
+	for (auto& callback : OnElementsAdd)
+		callback(this, std::span<const entityId>(ids, amount));
+
+	if constexpr (Initializable<Component>)
+	{
+		if (amount)
+			m_Tag.Initialize(GetRegistry());
+	}
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds)
+{
+	assert(target.GetTypeId() == GetTypeId() && &target != this);
+	auto& targetView{ static_cast<TypeView<Component>&>(target) };
+
+	// Tags have no data to move
+	targetView.AddEntities(targetIds, amount, nullptr);
+
+	for (size_t i{}; i < amount; ++i)
+	{
+		if (!IsActive(ids[i]))
+			targetView.SetInactive(targetIds[i]);
+	}
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+Component* TypeView<Component>::AddAfterUpdate(entityId id)
+{
+	m_AddedEntitiesUpdate.emplace_back(id);
+	return &m_Tag;
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::Remove(entityId id)
+{
+	if (m_EntitySet.contains(id))
+	{
+		for (auto& callback : OnElementRemove)
+			callback(this, id);
+
+		// The owning group may have moved the entity inside of the callbacks
+		SwapRemove(m_EntitySet.Find(id));
+	}
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::SetInactive(entityId id)
+{
+	assert(Contains(id));
+	if (!IsActive(id)) return;
+
+	// The owning group moves the entity out of the front before it is swapped to the inactive entities
+	for (auto& callback : OnElementDisable)
+		callback(this, id);
+
+	SwapPositions(GetActiveAmount() - 1, GetPositionInArray(id));
+	++m_InactiveItems;
+	++m_Version;
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::SetActive(entityId id)
+{
+	assert(Contains(id));
+	if (IsActive(id)) return;
+	SwapPositions(GetActiveAmount(), GetPositionInArray(id));
+	--m_InactiveItems;
+	++m_Version;
+
+	for (auto& callback : OnElementEnable)
+		callback(this, id);
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::SerializeView(std::ostream& stream)
+{
+	// Same layout as the views with data, with a data size of 0
+	WriteStream(stream, GetSize());
+	WriteStream(stream, m_InactiveItems);
+	stream.write(reinterpret_cast<const char*>(m_EntitySet.data()), GetSize() * sizeof(entityId));
+	WriteStream(stream, size_t{});
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::DeserializeView(std::istream& stream)
+{
+	assert(GetSize() == 0); // Check if view is empty
+
+	size_t size{};
+	ReadStream(stream, size);
+	ReadStream(stream, m_InactiveItems);
+
+	std::vector<entityId> entities(size);
+	stream.read(reinterpret_cast<char*>(entities.data()), size * sizeof(entityId));
+	m_EntitySet.Assign(entities.data(), size);
+
+	// Views of Components that were not empty when they were serialized still have data
+	size_t dataSize{};
+	ReadStream(stream, dataSize);
+	stream.seekg(dataSize, std::ios::cur);
+
+	m_Ticks.Assign(size, GetCurrentTick());
+	++m_Version;
+
+	for (size_t i{}; i < size; ++i)
+	{
+		for (auto& onAdd : OnElementAdd)
+			onAdd(this, m_EntitySet[i]);
+	}
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+TypeViewInfo TypeView<Component>::GetInfo()
+{
+	return TypeViewInfo
+	{
+		GetTypeId(),
+		TypeInformation::GetTypeName(GetTypeId()),
+		GetElementSize(),
+		GetSize(),
+		GetActiveAmount(),
+		GetInactiveAmount()
+	};
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::UpdateInfo(TypeViewInfo& info)
+{
+	info.totalSize = GetSize();
+	info.activeAmount = GetActiveAmount();
+	info.inactiveAmount = GetInactiveAmount();
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick)
+{
+	if (previous && IsUnchangedSince(*previous))
+	{
+		snapshot = previous;
+		return;
+	}
+
+	// Tags have no data, the snapshot only stores the entities
+	if (!snapshot || snapshot.use_count() > 1)
+		snapshot = std::make_shared<ViewSnapshot>();
+
+	WriteSnapshot(*snapshot, m_InactiveItems, tick);
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::RestoreSnapshot(const ViewSnapshot* snapshot)
+{
+	m_AddedEntitiesUpdate.clear();
+	m_InactiveItems = snapshot ? snapshot->inactiveAmount : 0;
+	m_GroupedAmount = snapshot ? snapshot->groupedAmount : 0;
+	++m_Version;
+
+	if (HasEntitiesOf(snapshot))
+	{
+		m_Ticks.SetAllChanged(GetCurrentTick());
+		return;
+	}
+
+	const size_t size{ snapshot ? snapshot->entities.size() : 0 };
+	m_EntitySet.Assign(size ? snapshot->entities.data() : nullptr, size);
+	m_Ticks.Assign(size, GetCurrentTick());
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::Enable(const VoidReference&)
+{
+	throw std::runtime_error("Tags are shared by all entities and can only be enabled using the entity");
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::Disable(const VoidReference&)
+{
+	throw std::runtime_error("Tags are shared by all entities and can only be disabled using the entity");
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+bool TypeView<Component>::IsEnabled(const VoidReference&) const
+{
+	throw std::runtime_error("Tags are shared by all entities, use IsEnabled(entityId) instead");
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::AddMap(entityId id)
+{
+	const size_t pos{ m_EntitySet.push_back(id) };
+	m_Ticks.push_back(GetCurrentTick());
+	++m_Version;
+
+	// keep the inactive entities at the back
+	if (m_InactiveItems)
+		SwapPositions(GetSize() - 1 - m_InactiveItems, pos);
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::SwapRemove(size_t pos)
+{
+	const size_t activeAmount{ GetActiveAmount() };
+	if (pos < activeAmount)
+	{
+		// Move the entity to the last active position and then swap it with the last entity, so all inactive entities stay at the back
+		SwapPositions(pos, activeAmount - 1);
+		SwapPositions(activeAmount - 1, GetSize() - 1);
+	}
+	else
+	{
+		SwapPositions(pos, GetSize() - 1);
+		--m_InactiveItems;
+	}
+
+	m_EntitySet.pop_back();
+	m_Ticks.pop_back();
+	++m_Version;
+}
+
+template <typename Component> requires std::is_empty_v<Component>
+void TypeView<Component>::SwapPositions(size_t pos0, size_t pos1)
+{
+	assert(pos0 < GetSize());
+	assert(pos1 < GetSize());
+	if (pos0 == pos1) return;
+
+	m_EntitySet.SwapPositions(pos0, pos1);
+	m_Ticks.SwapPositions(pos0, pos1);
+	++m_Version;
+
+	for (auto& callback : OnElementMove)
+	{
+		callback(this, m_EntitySet[pos0], pos0);
+		callback(this, m_EntitySet[pos1], pos1);
+	}
+}
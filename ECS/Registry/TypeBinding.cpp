@@ -79,131 +79,236 @@ void TypeBinding::PrintTypes(std::ostream& stream)
 		stream << '[' << m_pTypes[i] << ']';
 }
 
+void* TypeBinding::GetVoidPointer(size_t typePos, size_t elementPos) const
+{
+	TypeViewBase* view{ m_pViews[typePos] };
+	const size_t position{ m_Indices[elementPos * m_TypesAmount + typePos] };
+	return static_cast<std::byte*>(view->GetVoidData()) + position * view->GetElementSize();
+}
+
 void TypeBinding::Initialize()
 {
-	std::unique_ptr<TypeViewBase* []> typeViews = std::make_unique<TypeViewBase* []>(m_TypesAmount);
 	for (size_t i{}; i < m_TypesAmount; ++i)
 	{
-		typeViews[i] = m_pRegistry->GetOrCreateView(m_pTypes[i]);
+		m_pViews[i] = m_pRegistry->GetOrCreateView(m_pTypes[i]);
+		ComponentSignatures::SetMaskBit(m_Signature, m_pViews[i]->GetViewIndex());
 	}
 
 	// Get all the entities of the first view
-	auto& entities = typeViews[0]->GetRegisteredEntities();
-
-	for (auto entity : entities)
+	for (auto entity : m_pViews[0]->GetRegisteredEntities())
 	{
-		bool presentInAll{ true };
-
-		for (size_t i{ 1 }; i < m_TypesAmount; ++i)
-		{
-			if (!typeViews[i]->Contains(entity))
-			{
-				presentInAll = false;
-				break;
-			}
-		}
-
-		if (presentInAll)
-		{
-			push_back();
-			m_ContainedEntities.emplace(entity, back());
-
-			for (size_t i{ }; i < m_TypesAmount; ++i)
-			{
-				m_Data[m_Data.size() - m_TypesAmount + i] = typeViews[i]->GetVoidReference(entity);
-			}
-		}
+		if (ShouldContain(entity))
+			push_back(entity);
 	}
 	
 	auto OnElementAddFunction = [this](TypeViewBase*, entityId id)
 	{
-		bool presentInAll{ };
-
-		for (size_t i{}; i < GetTypeAmount(); ++i)
-		{
-			const auto typeId = m_pTypes[i];
-			if (!m_pRegistry->GetTypeView(typeId)->Contains(id))
-			{
-				return;
-			}
-
-			presentInAll = true;
-		}
+		if (ShouldContain(id))
+			Insert(id);
+	};
 
-		if (presentInAll)
+	auto OnElementsAddFunction = [this](TypeViewBase*, std::span<const entityId> ids)
+	{
+		for (entityId id : ids)
 		{
-			push_back();
-			m_ContainedEntities.emplace(id, back());
-
-			for (size_t i{ }; i < m_TypesAmount; ++i)
-			{
-				m_Data[m_Data.size() - m_TypesAmount + i] = m_pRegistry->GetTypeView(m_pTypes[i])->GetVoidReference(id);
-			}
+			if (ShouldContain(id))
+				Insert(id);
 		}
 	};
 
 	auto OnElementRemoveFunction = [this](TypeViewBase*, entityId id)
 	{
-		auto it = m_ContainedEntities.find(id);
-		if (it != m_ContainedEntities.end())
-		{
-			SwapRemove(it->second);
-			m_ContainedEntities.erase(it);
-		}
+		Erase(id);
 	};
 
+	// Disabled Components are only removed from owning groups, as they would otherwise be in the middle of the group
+	auto OnElementDisableFunction = [this](TypeViewBase*, entityId id)
+	{
+		if (m_IsOwning)
+			Erase(id);
+	};
+
+	auto OnElementEnableFunction = [this](TypeViewBase*, entityId id)
+	{
+		if (m_IsOwning && !m_ContainedEntities.contains(id) && ShouldContain(id))
+			Insert(id);
+	};
 
 	for (size_t i{}; i < m_TypesAmount; ++i)
 	{
-		typeViews[i]->OnElementAdd.emplace_back(OnElementAddFunction);
-		typeViews[i]->OnElementRemove.emplace_back(OnElementRemoveFunction);
+		m_pViews[i]->OnElementAdd.emplace_back(OnElementAddFunction);
+		m_pViews[i]->OnElementsAdd.emplace_back(OnElementsAddFunction);
+		m_pViews[i]->OnElementRemove.emplace_back(OnElementRemoveFunction);
+		m_pViews[i]->OnElementDisable.emplace_back(OnElementDisableFunction);
+		m_pViews[i]->OnElementEnable.emplace_back(OnElementEnableFunction);
+
+		// Only the position of this type is modified, as views of different types may move their elements concurrently while sorting
+		m_pViews[i]->OnElementMove.emplace_back([this, i](TypeViewBase*, entityId id, size_t position)
+			{
+				auto it = m_ContainedEntities.find(id);
+				if (it != m_ContainedEntities.end())
+					m_Indices[it->second * m_TypesAmount + i] = position;
+			});
 	}
 }
 
-void TypeBinding::push_back()
+void TypeBinding::Own()
 {
+	if (m_IsOwning)
+		return;
+
 	for (size_t i{}; i < m_TypesAmount; ++i)
-		m_Data.emplace_back();
+	{
+		if (m_pViews[i]->m_pOwner)
+			throw std::runtime_error("The view of " + std::string(TypeInformation::GetTypeName(m_pTypes[i])) + " is already owned by a different binding");
+	}
+
+	for (size_t i{}; i < m_TypesAmount; ++i)
+		m_pViews[i]->m_pOwner = this;
+
+	m_IsOwning = true;
+
+	// Insert the elements again in their current order, which moves them to the front of the views
+	const std::vector<entityId> entities{ std::move(m_Entities) };
+	m_Entities.clear();
+	m_Indices.clear();
+	m_ContainedEntities.clear();
+
+	for (entityId entity : entities)
+	{
+		if (ShouldContain(entity))
+			Insert(entity);
+	}
 }
 
-void TypeBinding::pop_back()
+bool TypeBinding::ShouldContain(entityId id) const
 {
-	for (size_t i{}; i < m_TypesAmount; ++i)
-		m_Data.pop_back();
+	if (!m_pRegistry->GetSignatures().ContainsAll(id, m_Signature))
+		return false;
+
+	if (m_IsOwning)
+	{
+		for (size_t i{}; i < m_TypesAmount; ++i)
+		{
+			if (!m_pViews[i]->IsEnabled(id))
+				return false;
+		}
+	}
+	return true;
 }
 
-void TypeBinding::move(size_t source, size_t target)
+void TypeBinding::Insert(entityId id)
 {
-	for (size_t i{}; i < m_TypesAmount; ++i)
-		m_Data[target + i] = m_Data[source + i];
+	if (m_IsOwning)
+	{
+		// Swap the Components to the position right behind the group, which becomes part of the group
+		const size_t groupPos{ m_Entities.size() };
+		for (size_t i{}; i < m_TypesAmount; ++i)
+		{
+			m_pViews[i]->SwapElements(m_pViews[i]->GetPosition(id), groupPos);
+			m_pViews[i]->m_GroupedAmount = groupPos + 1;
+		}
+	}
+
+	push_back(id);
 }
 
-size_t TypeBinding::back()
+void TypeBinding::Erase(entityId id)
 {
-	return (m_Data.size() - m_TypesAmount) / m_TypesAmount;
+	auto it = m_ContainedEntities.find(id);
+	if (it == m_ContainedEntities.end())
+		return;
+
+	const size_t pos{ it->second };
+	if (m_IsOwning)
+	{
+		// Swap the Components to the last position of the group, which is then no longer part of the group.
+		// The positions of both elements are updated through OnElementMove
+		const size_t last{ m_Entities.size() - 1 };
+		for (size_t i{}; i < m_TypesAmount; ++i)
+		{
+			m_pViews[i]->SwapElements(pos, last);
+			m_pViews[i]->m_GroupedAmount = last;
+		}
+	}
+
+	m_ContainedEntities.erase(id);
+	SwapRemove(pos);
 }
 
-void TypeBinding::SwapRemove(size_t pos)
+void TypeBinding::Restore(const std::vector<entityId>& entities)
 {
-	if (pos == (m_Data.size() - m_TypesAmount) / m_TypesAmount)
+	m_Entities.clear();
+	m_Indices.clear();
+	m_ContainedEntities.clear();
+
+	// The group was restored at the front of its views in this order, Insert only swaps the Components of a group that did not exist yet
+	if (m_IsOwning)
 	{
-		pop_back();
+		for (size_t i{}; i < m_TypesAmount; ++i)
+			m_pViews[i]->m_GroupedAmount = 0;
 	}
-	else
+
+	for (entityId entity : entities)
 	{
-		// use swap remove to remove the binding
-		// we need will also need to update the position in the m_ContainedEntities map
-		const auto elementAddress = m_Data[m_Data.size() - m_TypesAmount].GetReferencePointer<void>().m_ptr;
+		if (ShouldContain(entity))
+			Insert(entity);
+	}
+}
 
-		const uint32_t typeId = m_pTypes[0];
-		const entityId otherId = m_pRegistry->GetTypeView(typeId)->GetEntityId(elementAddress);
+void TypeBinding::push_back(entityId id)
+{
+	m_ContainedEntities.emplace(id, m_Entities.size());
+	m_Entities.emplace_back(id);
+	++m_Version;
 
-		// update the position of the swapped element
-		assert(m_ContainedEntities.contains(otherId));
-		m_ContainedEntities[otherId] = pos;
+	for (size_t i{}; i < m_TypesAmount; ++i)
+		m_Indices.emplace_back(m_pViews[i]->GetPosition(id));
+}
 
-		// swap remove
-		move(back(), pos);
-		pop_back();
+void TypeBinding::SwapRemove(size_t pos)
+{
+	// use swap remove to remove the element, the position of the swapped element has to be updated in the m_ContainedEntities map
+	const size_t last{ m_Entities.size() - 1 };
+	if (pos != last)
+	{
+		m_Entities[pos] = m_Entities[last];
+		m_ContainedEntities[m_Entities[pos]] = pos;
+
+		for (size_t i{}; i < m_TypesAmount; ++i)
+			m_Indices[pos * m_TypesAmount + i] = m_Indices[last * m_TypesAmount + i];
+	}
+
+	m_Entities.pop_back();
+	m_Indices.resize(m_Indices.size() - m_TypesAmount);
+	++m_Version;
+}
+
+void TypeBinding::ApplyOrder(const std::vector<size_t>& order)
+{
+	assert(order.size() == m_Entities.size());
+
+	std::vector<entityId> entities(order.size());
+	for (size_t i{}; i < order.size(); ++i)
+		entities[i] = m_Entities[order[i]];
+
+	if (m_IsOwning)
+	{
+		// Swap the Components of every element to their new position, the element that was there moves to the old position.
+		// Only positions at or after i are swapped, so the elements that were already placed stay in place
+		for (size_t i{}; i < entities.size(); ++i)
+		{
+			for (size_t type{}; type < m_TypesAmount; ++type)
+				m_pViews[type]->SwapElements(m_pViews[type]->GetPosition(entities[i]), i);
+		}
+	}
+
+	m_Entities.swap(entities);
+	++m_Version;
+	for (size_t i{}; i < m_Entities.size(); ++i)
+	{
+		m_ContainedEntities[m_Entities[i]] = i;
+		for (size_t type{}; type < m_TypesAmount; ++type)
+			m_Indices[i * m_TypesAmount + type] = m_pViews[type]->GetPosition(m_Entities[i]);
 	}
 }
@@ -1,14 +1,31 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <numeric>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "TypeViewBase.h"
 #include "../Entity/Entity.h"
 #include "../TypeInformation/TypeInformation.h"
+#include "../TypeInformation/Concepts.h"
 
 class EntityRegistry;
 
+/**
+ * Binds the Components of the entities that contain all the given types.
+ * For every element the binding stores the positions of its Components inside of the data arrays of the TypeViews,
+ * which are updated by the views whenever a Component moves. Accessing a Component is a single offset from the start of the view its array.
+ *
+ * An owning binding (group) keeps its entities packed at the front of every one of its views, in the same order.
+ * The Component of element i is then at position i of every view, so iterating is a zip over the contiguous fronts of the arrays.
+ * Only entities of which all Components are enabled are part of an owning group, and the views only sort the elements behind the group.
+ * A view can only be owned by one group.
+ */
 class TypeBinding final
 {
 public:
@@ -18,6 +35,7 @@ public:
 		: m_pRegistry(pRegistry)
 		, m_pTypes(std::make_unique<uint32_t[]>(sizeof...(Types)))
 		, m_TypesAmount(sizeof...(Types))
+		, m_pViews(std::make_unique<TypeViewBase*[]>(sizeof...(Types)))
 	{
 		static_assert(sizeof...(Types) >= 2);
 
@@ -33,6 +51,7 @@ public:
 		: m_pRegistry(pRegistry)
 		, m_pTypes(std::make_unique<uint32_t[]>(amount))
 		, m_TypesAmount(amount)
+		, m_pViews(std::make_unique<TypeViewBase*[]>(amount))
 	{
 		assert(amount >= 2);
 
@@ -60,71 +79,60 @@ public:
 	size_t GetEntityPos(entityId id) const
 	{
 		assert(m_ContainedEntities.contains(id));
-		return m_ContainedEntities.find(id)->first;
+		return m_ContainedEntities.find(id)->second;
 	}
 
-	const VoidReference& Get(size_t typePos, size_t elementPos) const
+	VoidReference Get(size_t typePos, size_t elementPos) const
 	{
-		return m_Data[elementPos * m_TypesAmount + typePos];
+		return m_pViews[typePos]->GetVoidReference(m_Entities[elementPos]);
 	}
 
-	const VoidReference& GetWithTypeId(uint32_t typeId, size_t elementPos) const
+	VoidReference GetWithTypeId(uint32_t typeId, size_t elementPos) const
 	{
 		return Get(GetTypePos(typeId), elementPos);
 	}
 
-	const VoidReference& GetEntity(size_t typePos, entityId id) const
+	VoidReference GetEntity(size_t typePos, entityId id) const
 	{
 		return Get(typePos, GetEntityPos(id));
 	}
 
-	const VoidReference& GetEntityWithTypeId(uint32_t typeId, entityId id) const
+	VoidReference GetEntityWithTypeId(uint32_t typeId, entityId id) const
 	{
 		return GetWithTypeId(typeId, GetEntityPos(id));
 	}
 
-	VoidReference& Get(size_t typePos, size_t elementPos)
-	{
-		return m_Data[elementPos * m_TypesAmount + typePos];
-	}
-
-	VoidReference& GetWithTypeId(uint32_t typeId, size_t elementPos)
+	template <typename T>
+	Reference<T> Get(size_t typePos, size_t elementPos) const
 	{
-		return Get(GetTypePos(typeId), elementPos);
+		return Get(typePos, elementPos).template ToReference<T>();
 	}
 
-	VoidReference& GetEntity(size_t typePos, entityId id)
-	{
-		return Get(typePos, GetEntityPos(id));
-	}
-
-	VoidReference& GetEntityWithTypeId(uint32_t typeId, entityId id)
-	{
-		return GetWithTypeId(typeId, GetEntityPos(id));
-	}
+	/** Returns the address of the Component without creating a Reference, which would modify the reference counter*/
+	void* GetVoidPointer(size_t typePos, size_t elementPos) const;
 
 	template <typename T>
-	Reference<T> Get(size_t typePos, size_t elementPos) const
+	T* GetPointer(size_t typePos, size_t elementPos) const
 	{
-		return Get(typePos, elementPos).ToReference<T>();
+		return static_cast<T*>(GetVoidPointer(typePos, elementPos));
 	}
 
 	template <typename T>
 	Reference<T> Get(size_t elementPos) const
 	{
-		return Get(reflection::type_id<T>(), elementPos).ToReference<T>();
+		return GetWithTypeId(reflection::type_id<T>(), elementPos).template ToReference<T>();
 	}
 
 	template <typename T>
 	Reference<T> GetEntity(size_t typePos, entityId id) const
 	{
-		return GetEntity(typePos, id).ToReference<T>();
+		return GetEntity(typePos, id).template ToReference<T>();
 	}
 
 	template <typename T>
 	Reference<T> GetEntityWithTypeId(entityId id) const
 	{
-		return GetEntity(reflection::type_id<T>(), id).ToReference<T>();
+		return GetEntityWithTypeId(reflection::type_id<T>(), id).template ToReference<T>();
 	}
 
 	const uint32_t* GetTypeIds(size_t& size) const
@@ -160,6 +168,10 @@ public:
 	template <typename... Types>
 	void ApplyFunctionOnAll(const std::function<void(Types&...)>& function);
 
+	/** Calls the function on the elements at the positions [begin, end)*/
+	template <typename... Types>
+	void ApplyFunctionOnRange(const std::function<void(Types&...)>& function, size_t begin, size_t end);
+
 	template <typename... Types>
 	void ApplyFunctionDT(const std::function<void(float, Types&...)>& function, size_t pos, float deltaTime);
 
@@ -169,34 +181,105 @@ public:
 	template <typename... Types>
 	void ApplyFunctionOnAllDT(const std::function<void(float, Types&...)>& function, float deltaTime);
 
+	template <typename... Types>
+	void ApplyFunctionOnRangeDT(const std::function<void(float, Types&...)>& function, size_t begin, size_t end, float deltaTime);
+
+	/** Calls a function object of any type on the elements at the positions [begin, end), the call can be inlined unlike with std::function*/
+	template <typename... Types, typename Function>
+	void ApplyCallableOnRange(Function&& function, size_t begin, size_t end);
+
 	bool Compare(const uint32_t* types, size_t size) const;
 
 	bool Contains(uint32_t typeId) const;
 
 	void PrintTypes(std::ostream& stream);
 
-	size_t GetSize() const { return m_ContainedEntities.size(); }
+	size_t GetSize() const { return m_Entities.size(); }
 
 	const auto& GetEntities() const { return m_ContainedEntities; }
 
+	/** The entity of every element, in the order in which the elements are iterated*/
+	const std::vector<entityId>& GetElementEntities() const { return m_Entities; }
+
+	/** Increased whenever an element is added, removed or reordered*/
+	uint32_t GetVersion() const { return m_Version; }
+
+	/** The positions of the Components of the elements inside of their views, every element has one position per type*/
+	const size_t* GetIndices() const { return m_Indices.data(); }
+
+	/** The distance in bytes between the positions of two elements*/
+	size_t GetElementStride() const { return sizeof(size_t) * m_TypesAmount; }
+
+	/**
+	 * Makes the binding take ownership of its views, its entities are moved to the front of the views.
+	 * Disabled Components are removed from the binding.
+	 * @throws std::runtime_error: when one of the views is already owned by a different binding
+	 */
+	void Own();
+
+	bool IsOwning() const { return m_IsOwning; }
+
+	/**
+	 * Stable sorts the elements using the comparison of their Components of type T.
+	 * An owning group moves the Components in all of its views, a binding that is not owning only changes the order in which its elements are iterated.
+	 * @returns false when the elements were already sorted, checking this only takes a single pass
+	 */
+	template <typename T, typename CompareFunction>
+	bool Sort(CompareFunction compare);
+
+	/** Sorts the elements using the SortCompare function of T*/
+	template <typename T> requires Sortable<T>
+	bool Sort() { return Sort<T>([](const T& component0, const T& component1) { return SortCompare(component0, component1); }); }
+
+	/**
+	 * Finds the elements again after the views were restored from a snapshot (see EntityRegistry::RestoreSnapshot).
+	 * The views do not call their callbacks when they are restored, so the binding does not know which Components moved.
+	 * @param entities: the entities of the elements in the order they had when the snapshot was taken
+	 */
+	void Restore(const std::vector<entityId>& entities);
+
 private:
 
+	template <typename... Types, typename Function, size_t... Indices>
+	static void ApplyCallable(Function& function, const std::array<std::byte*, sizeof...(Types)>& data,
+		const std::array<size_t, sizeof...(Types)>& elementSizes, const size_t* indices, std::index_sequence<Indices...>);
+
+	template <typename... Types, typename Function, size_t... Indices>
+	static void ApplyCallableAt(Function& function, const std::array<std::byte*, sizeof...(Types)>& data,
+		const std::array<size_t, sizeof...(Types)>& elementSizes, size_t position, std::index_sequence<Indices...>);
+
 	void Initialize();
-	void push_back();
-	void pop_back();
-	void move(size_t source, size_t target);
-	size_t back();
+	bool ShouldContain(entityId id) const;
+	void Insert(entityId id);
+	void Erase(entityId id);
+	void push_back(entityId id);
 	void SwapRemove(size_t pos);
 
+	/** Moves the element at position order[i] to position i*/
+	void ApplyOrder(const std::vector<size_t>& order);
+
 private:
 	EntityRegistry* m_pRegistry;
 
-	std::vector<VoidReference> m_Data;
 	const std::unique_ptr<uint32_t[]> m_pTypes;
 	const size_t m_TypesAmount{};
+	const std::unique_ptr<TypeViewBase*[]> m_pViews;
+
+	/** The entity of every element*/
+	std::vector<entityId> m_Entities;
+
+	/** The position of every Component of every element inside of its view, m_TypesAmount positions per element*/
+	std::vector<size_t> m_Indices;
 
 	std::unordered_map<entityId, size_t> m_ContainedEntities;
 
+	/** The bits of the views of the types, an entity is part of the binding when its signature contains all of them*/
+	std::vector<uint64_t> m_Signature;
+
+	bool m_IsOwning{};
+
+	uint32_t m_Version{};
+
 };
 
 template <typename ... Types>
@@ -208,12 +291,38 @@ bool TypeBinding::Assert() const
 	auto typeIds = reflection::Type_ids<Types...>();
 	for (size_t i{}; i < m_TypesAmount; ++i)
 	{
-		if (typeIds[i] != m_pTypes[i] && !TypeInformation::IsSubClass(m_pTypes[i], typeIds[i]))
+		if (typeIds[i] != m_pTypes[i] && !TypeInformation::IsSubClass(typeIds[i], m_pTypes[i]))
 			return false;
 	}
 	return true;
 }
 
+template <typename T, typename CompareFunction>
+bool TypeBinding::Sort(CompareFunction compare)
+{
+	const size_t typePos{ GetTypePos<T>() };
+	assert(typePos < m_TypesAmount);
+
+	const auto isLess = [this, typePos, &compare](size_t pos0, size_t pos1)
+	{
+		return compare(*GetPointer<const T>(typePos, pos0), *GetPointer<const T>(typePos, pos1));
+	};
+
+	bool isSorted{ true };
+	for (size_t i{ 1 }; i < GetSize() && isSorted; ++i)
+		isSorted = !isLess(i, i - 1);
+
+	if (isSorted)
+		return false;
+
+	std::vector<size_t> order(GetSize());
+	std::iota(order.begin(), order.end(), size_t{});
+	std::stable_sort(order.begin(), order.end(), isLess);
+
+	ApplyOrder(order);
+	return true;
+}
+
 template <typename ... Types>
 void TypeBinding::ApplyFunctionOnEntity(const std::function<void(Types&...)>& function, entityId id) 
 {
@@ -223,11 +332,13 @@ void TypeBinding::ApplyFunctionOnEntity(const std::function<void(Types&...)>& fu
 template <typename ... Types>
 void TypeBinding::ApplyFunctionOnAll(const std::function<void(Types&...)>& function) 
 {
-	const size_t size{ m_Data.size() / m_TypesAmount };
-	for (size_t i{}; i < size; ++i)
-	{
-		ApplyFunction(function, i);
-	}
+	ApplyFunctionOnRange(function, 0, GetSize());
+}
+
+template <typename ... Types>
+void TypeBinding::ApplyFunctionOnRange(const std::function<void(Types&...)>& function, size_t begin, size_t end)
+{
+	ApplyCallableOnRange<Types...>(function, begin, end);
 }
 
 
@@ -240,107 +351,72 @@ void TypeBinding::ApplyFunctionOnEntityDT(const std::function<void(float, Types&
 template <typename ... Types>
 void TypeBinding::ApplyFunctionOnAllDT(const std::function<void(float, Types&...)>& function, float deltaTime)
 {
-	const size_t size{ m_Data.size() / m_TypesAmount };
-	for (size_t i{}; i < size; ++i)
-	{
-		ApplyFunctionDT(function, i, deltaTime);
-	}
+	ApplyFunctionOnRangeDT(function, 0, GetSize(), deltaTime);
 }
 
 template <typename ... Types>
-void TypeBinding::ApplyFunction(const std::function<void(Types&...)>& function, size_t pos) 
+void TypeBinding::ApplyFunctionOnRangeDT(const std::function<void(float, Types&...)>& function, size_t begin, size_t end, float deltaTime)
 {
-	assert(sizeof...(Types) == m_TypesAmount);
+	ApplyCallableOnRange<Types...>([&function, deltaTime](Types&... components) { function(deltaTime, components...); }, begin, end);
+}
+
+template <typename... Types, typename Function>
+void TypeBinding::ApplyCallableOnRange(Function&& function, size_t begin, size_t end)
+{
+	constexpr size_t typesAmount{ sizeof...(Types) };
+
+	assert(typesAmount == m_TypesAmount);
 	assert(Assert<Types...>());
+	assert(end <= GetSize());
 
-	if constexpr (sizeof...(Types) == 2)
-	{
-		function(
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 3)
-	{
-		function(
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 4)
+	// The data arrays do not move while iterating, so their address only has to be retrieved once
+	std::array<std::byte*, typesAmount> data;
+	std::array<size_t, typesAmount> elementSizes;
+	for (size_t i{}; i < typesAmount; ++i)
 	{
-		function(
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get());
+		data[i] = static_cast<std::byte*>(m_pViews[i]->GetVoidData());
+		elementSizes[i] = m_pViews[i]->GetElementSize();
 	}
-	else if constexpr (sizeof...(Types) == 5)
+
+	// The Components of the elements of an owning group are at the same position in every view
+	if (m_IsOwning)
 	{
-		function(
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get(),
-			*Get<std::tuple_element_t<4, std::tuple<Types...>>>(4, pos).get());
+		for (size_t i{ begin }; i < end; ++i)
+		{
+			ApplyCallableAt<Types...>(function, data, elementSizes, i, std::index_sequence_for<Types...>{});
+		}
+		return;
 	}
-	else if constexpr (sizeof...(Types) == 6)
+
+	const size_t* indices{ m_Indices.data() + begin * typesAmount };
+	for (size_t i{ begin }; i < end; ++i, indices += typesAmount)
 	{
-		function(
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get(),
-			*Get<std::tuple_element_t<4, std::tuple<Types...>>>(4, pos).get(),
-			*Get<std::tuple_element_t<5, std::tuple<Types...>>>(5, pos).get());
+		ApplyCallable<Types...>(function, data, elementSizes, indices, std::index_sequence_for<Types...>{});
 	}
-	static_assert(sizeof...(Types) <= 6, "Please expand this sequence");
+}
+
+template <typename... Types, typename Function, size_t... Indices>
+void TypeBinding::ApplyCallable(Function& function, const std::array<std::byte*, sizeof...(Types)>& data,
+	const std::array<size_t, sizeof...(Types)>& elementSizes, const size_t* indices, std::index_sequence<Indices...>)
+{
+	function(*reinterpret_cast<Types*>(data[Indices] + indices[Indices] * elementSizes[Indices])...);
+}
+
+template <typename... Types, typename Function, size_t... Indices>
+void TypeBinding::ApplyCallableAt(Function& function, const std::array<std::byte*, sizeof...(Types)>& data,
+	const std::array<size_t, sizeof...(Types)>& elementSizes, size_t position, std::index_sequence<Indices...>)
+{
+	function(*reinterpret_cast<Types*>(data[Indices] + position * elementSizes[Indices])...);
 }
 
 template <typename ... Types>
-void TypeBinding::ApplyFunctionDT(const std::function<void(float, Types&...)>& function, size_t pos, float deltaTime)
+void TypeBinding::ApplyFunction(const std::function<void(Types&...)>& function, size_t pos) 
 {
-	assert(sizeof...(Types) == m_TypesAmount);
-	assert(Assert<Types...>());
+	ApplyCallableOnRange<Types...>(function, pos, pos + 1);
+}
 
-	if constexpr (sizeof...(Types) == 2)
-	{
-		function( deltaTime,
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 3)
-	{
-		function( deltaTime,
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 4)
-	{
-		function( deltaTime,
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 5)
-	{
-		function( deltaTime,
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get(),
-			*Get<std::tuple_element_t<4, std::tuple<Types...>>>(4, pos).get());
-	}
-	else if constexpr (sizeof...(Types) == 6)
-	{
-		function( deltaTime,
-			*Get<std::tuple_element_t<0, std::tuple<Types...>>>(0, pos).get(),
-			*Get<std::tuple_element_t<1, std::tuple<Types...>>>(1, pos).get(),
-			*Get<std::tuple_element_t<2, std::tuple<Types...>>>(2, pos).get(),
-			*Get<std::tuple_element_t<3, std::tuple<Types...>>>(3, pos).get(),
-			*Get<std::tuple_element_t<4, std::tuple<Types...>>>(4, pos).get(),
-			*Get<std::tuple_element_t<5, std::tuple<Types...>>>(5, pos).get());
-	}
-	static_assert(sizeof...(Types) <= 6, "Please expand this sequence");
+template <typename ... Types>
+void TypeBinding::ApplyFunctionDT(const std::function<void(float, Types&...)>& function, size_t pos, float deltaTime)
+{
+	ApplyFunctionOnRangeDT(function, pos, pos + 1, deltaTime);
 }
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <cassert>
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <ranges>
+#include <span>
 #include <string>
 
 #include "../TypeInformation/reflection.h"
 #include "../Allocators/ObjectPoolAllocator.h"
+#include "../Allocators/ComponentAllocator.h"
+#include "../DataAccess/PagedArray.h"
 #include "../Sorting/SmoothSort.h"
 #include "TypeViewBase.h"
 #include "../Serialize/Serializer.h"
@@ -18,6 +21,13 @@
 
 inline bool SortCompare(const int& i0, const int& i1) { return i0 < i1; }
 
+/** Snapshot of a view that also stores a copy of its Components, at the same positions as the entities*/
+template <typename Component>
+struct ComponentSnapshot final : ViewSnapshot
+{
+	std::vector<Component> data;
+};
+
 template <typename Component>
 class TypeView : public TypeViewBase
 {
@@ -25,11 +35,20 @@ public:
 
 	using ComponentType = Component;
 
+	/** The allocator of the data array, chosen by the Component (see ComponentAllocatorType)*/
+	using Allocator = ComponentAllocator<Component>;
+
+	/** The data array, Components with a MaxComponents are kept in a PagedArray that never moves them*/
+	using Storage = std::conditional_t<PagedStorable<Component>, PagedArray<Component>, std::vector<Component, Allocator>>;
+
+	/** The reference pointers of the elements, kept in a PagedArray as well for Components with a MaxComponents*/
+	using ReferenceArray = std::conditional_t<PagedStorable<Component>, PagedArray<ReferencePointer<Component>*>, std::vector<ReferencePointer<Component>*>>;
+
 	constexpr static float ReferenceRemovalInterval{ 1 };
 
 public:
 
-	TypeView(EntityRegistry* pRegistry) : TypeViewBase(pRegistry) {}
+	TypeView(EntityRegistry* pRegistry);
 	~TypeView() override = default;
 
 	TypeView(const TypeView&) = delete;
@@ -60,6 +79,12 @@ public:
 
 	Reference<Component> Add(Entity entity);
 
+	/**
+	 * Adds a copy of components[i] to the entity ids[i].
+	 * The view grows at most once, the Components are appended as one block and OnElementsAdd is called once after all of them were added.
+	 */
+	void Add(std::span<const entityId> ids, std::span<const Component> components);
+
 	Component* AddAfterUpdate(entityId id);
 
 	Component* AddAfterUpdate(Entity entity);
@@ -70,8 +95,6 @@ public:
 	 */
 	void Remove(entityId id) override;
 
-	bool Contains(entityId id) override;
-
 	/** Returns the amount of elements inside of the underlying array.*/
 	size_t GetSize() const { return m_Data.size(); }
 
@@ -83,6 +106,13 @@ public:
 
 	/** Returns the array of instances of Type Component stored inside of the view*/
 	const Component* GetData() const { return m_Data.data(); }
+	Component* GetData() { return m_Data.data(); }
+
+	/**
+	 * Returns the size of the elements in the underlying array.
+	 * This is bigger than the size of Component when a view of a sub class is accessed as a view of its base class.
+	 */
+	size_t GetElementSize() const override { return m_ElementSize; }
 
 	/** Returns the start iterator of the data*/
 	auto begin() { return VoidIteratorType<Component>(m_Data.data(), m_ElementSize); }
@@ -90,9 +120,9 @@ public:
 	/** Returns the end of the iterator without inactive items*/
 	auto end() { return VoidIteratorType<Component>(m_Data.data() + m_Data.size(), m_ElementSize) - m_InactiveItems; }
 
-	auto beginInactives() { return VoidIteratorType<Component>(m_Data, m_ElementSize) + GetActiveAmount(); }
+	auto beginInactives() { return VoidIteratorType<Component>(m_Data.data(), m_ElementSize) + GetActiveAmount(); }
 
-	auto endInactive() { return VoidIteratorType<Component>(m_Data.back(), m_ElementSize) + 1; }
+	auto endInactive() { return VoidIteratorType<Component>(m_Data.data() + m_Data.size(), m_ElementSize); }
 
 	/** Returns the end of the array, including the inactive items*/
 	auto arrayEnd() { return m_Data.end(); }
@@ -113,6 +143,11 @@ public:
 
 	bool IsActive(const Component* element) const;
 
+	using TypeViewBase::MarkChanged;
+
+	/** Marks the element as changed at the current tick of the registry*/
+	void MarkChanged(const Component* element);
+
 	uint32_t GetTypeId() const override { return typeId; }
 
 	void SerializeView(std::ostream& stream) override;
@@ -125,8 +160,20 @@ public:
 
 	void UpdateInfo(TypeViewInfo&) override;
 
+	void TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick) override;
+
+	void RestoreSnapshot(const ViewSnapshot* snapshot) override;
+
+	void RestoreData(const ViewSnapshot& snapshot) override;
+
 	VoidReference AddEntity(entityId id) override;
 
+	VoidReference AddEntity(entityId id, void* component) override;
+
+	void AddEntities(const entityId* ids, size_t amount, const void* component) override;
+
+	void MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds) override;
+
 	void* AddAfterUpdate_void(entityId id) override;
 
 	void Enable(const VoidReference& ref) override;
@@ -143,29 +190,43 @@ private:
 
 	VoidIterator GetVoidIteratorEnd() override;
 
-	/** Creates a map between the id and the data and vice-versa*/
-	Reference<Component> AddMap(entityId id, Component* data);
+	void* GetVoidData() override { return m_Data.data(); }
 
-	/** Resizes the DataEntityMap and fills it with invalid ids*/
-	void ResizeDataEntityMap(size_t size);
+	static Storage CreateStorage();
+	static ReferenceArray CreateReferenceArray();
 
-	/** Checks if the DataEntityMap has enough capacity and will resize the map whenever it is too small*/
-	void CheckDataEntityMap(size_t size);
+	/**
+	 * Creates a map between the id and the data that was just added at the back of the data array and vice-versa.
+	 * Moves the element in front of the inactive elements and returns its reference.
+	 */
+	Reference<Component> AddMap(entityId id);
 
+	/**
+	 * Adds amount elements to the entities using a single growth of the arrays.
+	 * @param append: appends the amount Components to the data array
+	 */
+	template <typename Function>
+	void AddBatch(const entityId* ids, size_t amount, Function&& append);
+
+	/** Grows the arrays to fit at least capacity elements and points the references to the new positions of their elements, paged elements do not move*/
+	void ResizeData(size_t capacity);
 	void ResizeData();
 
 	void CheckDataSize();
 
-	/** Removes an element by swapping the last one with the element and popping the back*/
+	/** Removes an element by swapping it to the back of the array and popping the back while keeping the inactive elements at the end*/
 	void SwapRemove(size_t pos);
-	
-	void ChangeMapping(size_t oldPos, size_t newPos);
+
+	/** Removes the element at the back of the array and invalidates its reference*/
+	void PopBack();
 
 	void SetViewDataFlag(ViewDataFlag flag);
 
 	void SwapPositions(size_t pos0, size_t pos1);
 
-	void SortData(volatile SortingProgress& sortingProgress, const volatile bool& quit) override;
+	void SwapElements(size_t pos0, size_t pos1) override { SwapPositions(pos0, pos1); }
+
+	void SortData() override;
 
 	size_t GetPositionInArray(entityId id) const;
 
@@ -174,8 +235,10 @@ private:
 
 private:
 
-	std::vector<Component> m_Data;
-	std::unordered_map<entityId, ReferencePointer<Component>*> m_EntityDataReferences;
+	Storage m_Data;
+
+	/** The reference pointers of the elements, at the same position as their element in m_Data*/
+	ReferenceArray m_References;
 
 	/** Amount of inactive items inside of the array*/
 	size_t m_InactiveItems{};
@@ -184,6 +247,9 @@ private:
 
 	std::vector<ReferencePointer<Component>*> m_PendingDeleteReferences;
 
+	/** The reference pointers of the restored elements, kept between restores so restoring does not allocate*/
+	std::vector<ReferencePointer<Component>*> m_RestoredReferences;
+
 	std::vector<std::pair<entityId, Component>> m_AddedEntitiesUpdate;
 
 	const uint32_t typeId{ reflection::type_id<Component>() };
@@ -193,6 +259,16 @@ private:
 
 };
 
+template <typename T>
+TypeView<T>::TypeView(EntityRegistry* pRegistry)
+	: TypeViewBase(pRegistry)
+	, m_Data(CreateStorage())
+	, m_References(CreateReferenceArray())
+{
+	if constexpr (PagedStorable<T>)
+		SetMaxSize(size_t(T::MaxComponents));
+}
+
 template <typename T>
 void TypeView<T>::Update(float deltaTime)
 {
@@ -225,24 +301,23 @@ void TypeView<T>::Update(float deltaTime)
 template <typename T>
 entityId TypeView<T>::GetEntityId(const T* element) const
 {
-	assert(m_Data.data() - element < m_Data.size());
-	return m_DataEntityMap[m_Data.data() - element];
+	return m_EntitySet[GetPositionInArray(element)];
 }
 
 template <typename T>
 entityId TypeView<T>::GetEntityId(const void* elementAddress)
 {
 	const T* element = static_cast<const T*>(elementAddress);
-	return m_DataEntityMap[GetPositionInArray(element)];
+	return m_EntitySet[GetPositionInArray(element)];
 }
 
 template <typename T>
 Reference<T> TypeView<T>::Get(entityId id) const
 {
-	auto it = m_EntityDataReferences.find(id);
-	if (it != m_EntityDataReferences.end())
+	const size_t pos{ m_EntitySet.Find(id) };
+	if (pos != SparseSet::InvalidPos)
 	{
-		return *it->second;
+		return *m_References[pos];
 	}
 	return Reference<T>::InvalidRef();
 }
@@ -250,15 +325,22 @@ Reference<T> TypeView<T>::Get(entityId id) const
 template <typename T>
 VoidReference TypeView<T>::GetVoidReference(entityId id) const
 {
-	return VoidReference(static_cast<void*>(&Get(id).GetReferencePointer()));
+	const size_t pos{ m_EntitySet.Find(id) };
+	if (pos != SparseSet::InvalidPos)
+	{
+		return VoidReference(static_cast<void*>(m_References[pos]));
+	}
+	return VoidReference(nullptr);
 }
 
 template <typename T>
 Reference<T> TypeView<T>::Add(entityId id, const T& data)
 {
+	assert(!Contains(id));
+
 	CheckDataSize();
-	T* element = &m_Data.emplace_back(data);
-	auto ref = AddMap(id, element);
+	m_Data.emplace_back(data);
+	auto ref = AddMap(id);
 	for (auto& callback : OnElementAdd)
 		callback(this, id);
 
@@ -266,7 +348,7 @@ Reference<T> TypeView<T>::Add(entityId id, const T& data)
 
 	if constexpr (Initializable<T>)
 	{
-		*element.Initialize(GetRegistry());
+		ref->Initialize(GetRegistry());
 	}
 
 	return ref;
@@ -275,9 +357,11 @@ Reference<T> TypeView<T>::Add(entityId id, const T& data)
 template <typename T>
 Reference<T> TypeView<T>::Add(entityId id, T&& data)
 {
+	assert(!Contains(id));
+
 	CheckDataSize();
-	T* element = &m_Data.emplace_back(std::move(data));
-	auto ref = AddMap(id, element);
+	m_Data.emplace_back(std::move(data));
+	auto ref = AddMap(id);
 	for (auto& callback : OnElementAdd)
 		callback(this, id);
 
@@ -285,7 +369,7 @@ Reference<T> TypeView<T>::Add(entityId id, T&& data)
 
 	if constexpr (Initializable<T>)
 	{
-		*element.Initialize(GetRegistry());
+		ref->Initialize(GetRegistry());
 	}
 
 	return ref;
@@ -294,9 +378,11 @@ Reference<T> TypeView<T>::Add(entityId id, T&& data)
 template <typename T>
 Reference<T> TypeView<T>::Add(entityId id)
 {
+	assert(!Contains(id));
+
 	CheckDataSize();
-	T* element = &m_Data.emplace_back();
-	auto ref = AddMap(id, element);
+	m_Data.emplace_back();
+	auto ref = AddMap(id);
 	for (auto& callback : OnElementAdd)
 		callback(this, id);
 
@@ -304,7 +390,7 @@ Reference<T> TypeView<T>::Add(entityId id)
 
 	if constexpr (Initializable<T>)
 	{
-		*element.Initialize(GetRegistry());
+		ref->Initialize(GetRegistry());
 	}
 
 	return ref;
@@ -331,64 +417,57 @@ T* TypeView<T>::AddAfterUpdate(Entity entity)
 template <typename T>
 void TypeView<T>::Remove(entityId id)
 {
-	auto it = m_EntityDataReferences.find(id);
-	if (it != m_EntityDataReferences.end())
+	if (m_EntitySet.contains(id))
 	{
 		for (auto& callback : OnElementRemove)
 			callback(this, id);
 
-		size_t pos = it->second->m_ptr - m_Data.data();
-
-		// swap remove
-		m_Data[pos] = std::move(m_Data.back());
-		m_Data.pop_back();
-
-		// deallocate if no references to the element exists
-		if (it->second->GetReferencesAmount() == 0)
-			m_ReferencePool.deallocate(it->second);
-		else
-			m_PendingDeleteReferences.push_back(it->second);
-
-		m_EntityDataReferences.erase(it);
+		// The owning group may have moved the element inside of the callbacks
+		SwapRemove(m_EntitySet.Find(id));
 
 		SetViewDataFlag(ViewDataFlag::dirty);
 	}
 }
 
-template <typename T>
-bool TypeView<T>::Contains(entityId id)
-{
-	return (m_EntityDataReferences.contains(id));
-}
-
 template <typename T>
 void TypeView<T>::SetInactive(entityId id)
 {
-	assert(m_EntityDataReferences.contains(id));
-	SwapPositions( GetActiveAmount() - 1, GetPositionInArray(id));
+	assert(Contains(id));
+	if (!IsActive(id)) return;
+
+	// The owning group moves the element out of the front of the array before it is swapped to the inactive elements
+	for (auto& callback : OnElementDisable)
+		callback(this, id);
+
+	SwapPositions(GetActiveAmount() - 1, GetPositionInArray(id));
 	++m_InactiveItems;
+	++m_Version;
 }
 
 template <typename T>
 void TypeView<T>::SetInactive(const T* element)
 {
-	SwapPositions(GetActiveAmount() - 1, GetPositionInArray(element));
-	++m_InactiveItems;
+	// The element may be moved by the callbacks, so it is disabled through its entity
+	SetInactive(m_EntitySet[GetPositionInArray(element)]);
 }
 
 template <typename T>
 void TypeView<T>::SetActive(entityId id)
 {
-	assert(m_EntityDataReferences.contains(id));
+	assert(Contains(id));
+	if (IsActive(id)) return;
 	SwapPositions(GetActiveAmount(), GetPositionInArray(id));
 	--m_InactiveItems;
+	++m_Version;
+
+	for (auto& callback : OnElementEnable)
+		callback(this, id);
 }
 
 template <typename T>
 void TypeView<T>::SetActive(const T* element)
 {
-	SwapPositions(GetActiveAmount(), GetPositionInArray(element));
-	--m_InactiveItems;
+	SetActive(m_EntitySet[GetPositionInArray(element)]);
 }
 
 template <typename Component>
@@ -403,6 +482,12 @@ bool TypeView<Component>::IsActive(const Component* element) const
 	return GetPositionInArray(element) < GetActiveAmount();
 }
 
+template <typename Component>
+void TypeView<Component>::MarkChanged(const Component* element)
+{
+	m_Ticks.SetChanged(GetPositionInArray(element), GetCurrentTick());
+}
+
 template <typename Component>
 void TypeView<Component>::SerializeView(std::ostream& stream)
 {
@@ -410,7 +495,7 @@ void TypeView<Component>::SerializeView(std::ostream& stream)
 	WriteStream(stream, m_InactiveItems);
 
 	// Serialize the Data Entities map
-	stream.write(reinterpret_cast<const char*>(m_DataEntityMap.data()), GetSize() * sizeof(entityId));
+	stream.write(reinterpret_cast<const char*>(m_EntitySet.data()), GetSize() * sizeof(entityId));
 
 	//static_assert(std::is_trivially_copyable_v<Component> || Streamable<Component>, 
 	//	"Component has to be trivially copyable (POD) for a Serialize and Deserialize method not to exist for the Component.\n Please define both Serialize(std::ostream&) and Deserialize(std::istream&) methods for the Component");
@@ -455,11 +540,16 @@ void TypeView<Component>::DeserializeView(std::istream& stream)
 	ReadStream(stream, m_InactiveItems);
 
 	// Resize the vectors
-	ResizeDataEntityMap(size);
 	m_Data.resize(size);
 
 	// Get all entities
-	stream.read(reinterpret_cast<char*>(m_DataEntityMap.data()), size * sizeof(entityId));
+	std::vector<entityId> entities(size);
+	stream.read(reinterpret_cast<char*>(entities.data()), size * sizeof(entityId));
+	m_EntitySet.Assign(entities.data(), size);
+
+	// The change ticks are not serialized, the deserialized Components count as added and changed now
+	m_Ticks.Assign(size, GetCurrentTick());
+	++m_Version;
 
 	// Get the data size
 	size_t dataSize{};
@@ -489,18 +579,18 @@ void TypeView<Component>::DeserializeView(std::istream& stream)
 			+ std::to_string(dataSize) + ") was different from amount read (" + std::to_string(endPos - beginPos) + ")");
 	}
 
-	// Fill containers, create references, and create maps for each entity
+	// Create the references for each entity
+	m_References.resize(size);
 	for (size_t i{}; i < size; ++i)
 	{
-		// create the references
-		auto reference = m_ReferencePool.allocate();
-		reference->m_ptr = &m_Data[i];
-
-		// insert into entity data map
-		m_EntityDataReferences.emplace(m_DataEntityMap[i], reference);
+		auto reference = new (m_ReferencePool.allocate()) ReferencePointer<Component>(&m_Data[i]);
+		m_References[i] = reference;
+	}
 
+	for (size_t i{}; i < size; ++i)
+	{
 		for (auto& onAdd : OnElementAdd)
-			onAdd(this, m_DataEntityMap[i]);
+			onAdd(this, m_EntitySet[i]);
 	}
 }
 
@@ -532,12 +622,211 @@ void TypeView<Component>::UpdateInfo(TypeViewInfo& info)
 	info.inactiveAmount = GetInactiveAmount();
 }
 
+template <typename Component>
+void TypeView<Component>::TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick)
+{
+	if (previous && IsUnchangedSince(*previous))
+	{
+		snapshot = previous;
+		return;
+	}
+
+	if constexpr (std::is_copy_assignable_v<Component>)
+	{
+		// A snapshot that is still shared with a newer snapshot may not be overwritten
+		if (!snapshot || snapshot.use_count() > 1)
+			snapshot = std::make_shared<ComponentSnapshot<Component>>();
+
+		// Trivially copyable Components are copied as a single block
+		static_cast<ComponentSnapshot<Component>&>(*snapshot).data.assign(m_Data.begin(), m_Data.end());
+		WriteSnapshot(*snapshot, m_InactiveItems, tick);
+	}
+	else
+	{
+		throw std::runtime_error("Can not take a snapshot of " + std::string(reflection::type_name<Component>()) + " because it is not copyable");
+	}
+}
+
+template <typename Component>
+void TypeView<Component>::RestoreSnapshot(const ViewSnapshot* snapshot)
+{
+	const auto* components{ static_cast<const ComponentSnapshot<Component>*>(snapshot) };
+	const size_t size{ snapshot ? snapshot->entities.size() : 0 };
+
+	m_AddedEntitiesUpdate.clear();
+	m_InactiveItems = snapshot ? snapshot->inactiveAmount : 0;
+	m_GroupedAmount = snapshot ? snapshot->groupedAmount : 0;
+	m_DataFlag = snapshot ? snapshot->dataFlag : ViewDataFlag::valid;
+	++m_Version;
+
+	// When the entities did not change only the Components are copied, the elements and their references stay at the same positions
+	if (HasEntitiesOf(snapshot))
+	{
+		if constexpr (std::is_copy_assignable_v<Component>)
+		{
+			if (components)
+				std::copy(components->data.begin(), components->data.end(), m_Data.begin());
+		}
+		m_Ticks.SetAllChanged(GetCurrentTick());
+		return;
+	}
+
+	// Keep the reference pointers of the entities that exist in both states, so their References stay valid
+	m_RestoredReferences.assign(size, nullptr);
+	for (size_t i{}; i < size; ++i)
+	{
+		const size_t pos{ m_EntitySet.Find(snapshot->entities[i]) };
+		if (pos != SparseSet::InvalidPos)
+		{
+			m_RestoredReferences[i] = m_References[pos];
+			m_References[pos] = nullptr;
+		}
+	}
+
+	// Invalidate the references of the entities that do not exist in the snapshot
+	for (ReferencePointer<Component>* reference : m_References)
+	{
+		if (!reference)
+			continue;
+
+		reference->m_ptr = nullptr;
+		if (reference->GetReferencesAmount() == 0)
+			m_ReferencePool.deallocate(reference);
+		else
+			m_PendingDeleteReferences.push_back(reference);
+	}
+
+	if constexpr (std::is_copy_assignable_v<Component>)
+	{
+		if (components)
+			m_Data.assign(components->data.begin(), components->data.end());
+		else
+			m_Data.clear();
+	}
+	else
+	{
+		assert(!components);
+		m_Data.clear();
+	}
+
+	if constexpr (PagedStorable<Component>)
+		m_References.assign(m_RestoredReferences.begin(), m_RestoredReferences.end());
+	else
+		m_References.swap(m_RestoredReferences);
+	for (size_t i{}; i < size; ++i)
+	{
+		if (m_References[i])
+			m_References[i]->m_ptr = &m_Data[i];
+		else
+			m_References[i] = new (m_ReferencePool.allocate()) ReferencePointer<Component>(&m_Data[i]);
+	}
+
+	m_EntitySet.Assign(size ? snapshot->entities.data() : nullptr, size);
+	m_Ticks.Assign(size, GetCurrentTick());
+}
+
+template <typename Component>
+void TypeView<Component>::RestoreData(const ViewSnapshot& snapshot)
+{
+	if constexpr (std::is_trivially_copyable_v<Component>)
+	{
+		const auto& components{ static_cast<const ComponentSnapshot<Component>&>(snapshot) };
+		assert(components.data.size() == m_Data.size());
+		std::copy(components.data.begin(), components.data.end(), m_Data.begin());
+		m_Ticks.SetAllChanged(GetCurrentTick());
+	}
+}
+
 template <typename Component>
 VoidReference TypeView<Component>::AddEntity(entityId id)
 {
 	return VoidReference(static_cast<void*>(&Add(id).GetReferencePointer()));
 }
 
+template <typename Component>
+VoidReference TypeView<Component>::AddEntity(entityId id, void* component)
+{
+	return VoidReference(static_cast<void*>(&Add(id, std::move(*static_cast<Component*>(component))).GetReferencePointer()));
+}
+
+template <typename Component>
+void TypeView<Component>::AddEntities(const entityId* ids, size_t amount, const void* component)
+{
+	const Component& prototype{ *static_cast<const Component*>(component) };
+	AddBatch(ids, amount, [this, amount, &prototype]() { m_Data.insert(m_Data.end(), amount, prototype); });
+}
+
+template <typename Component>
+void TypeView<Component>::MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds)
+{
+	assert(target.GetTypeId() == GetTypeId() && &target != this);
+	auto& targetView{ static_cast<TypeView<Component>&>(target) };
+
+	targetView.AddBatch(targetIds, amount, [this, ids, amount, &targetView]()
+		{
+			for (size_t i{}; i < amount; ++i)
+				targetView.m_Data.emplace_back(std::move(m_Data[GetPositionInArray(ids[i])]));
+		});
+
+	for (size_t i{}; i < amount; ++i)
+	{
+		if (!IsActive(ids[i]))
+			targetView.SetInactive(targetIds[i]);
+	}
+}
+
+template <typename Component>
+void TypeView<Component>::Add(std::span<const entityId> ids, std::span<const Component> components)
+{
+	assert(ids.size() == components.size());
+	AddBatch(ids.data(), ids.size(), [this, components]() { m_Data.insert(m_Data.end(), components.begin(), components.end()); });
+}
+
+template <typename Component>
+template <typename Function>
+void TypeView<Component>::AddBatch(const entityId* ids, size_t amount, Function&& append)
+{
+	if (amount == 0)
+		return;
+
+	const size_t begin{ m_Data.size() };
+	if (begin + amount > m_Data.capacity())
+		ResizeData(std::max(begin + amount, m_Data.capacity() * 2));
+
+	// Trivially copyable Components are copied as a single block
+	append();
+	assert(m_Data.size() == begin + amount);
+
+	const ChangeTicks::Tick tick{ GetCurrentTick() };
+	++m_Version;
+	for (size_t i{}; i < amount; ++i)
+	{
+		assert(!Contains(ids[i]));
+		m_References.emplace_back(new (m_ReferencePool.allocate()) ReferencePointer<Component>(&m_Data[begin + i]));
+		m_EntitySet.push_back(ids[i]);
+		m_Ticks.push_back(tick);
+	}
+
+	// Keep the inactive elements at the back of the array, every new element swaps with the first inactive element
+	if (m_InactiveItems)
+	{
+		for (size_t i{}; i < amount; ++i)
+			SwapPositions(begin - m_InactiveItems + i, begin + i);
+	}
+
+	SetViewDataFlag(ViewDataFlag::dirty);
+
+	for (auto& callback : OnElementsAdd)
+		callback(this, std::span<const entityId>(ids, amount));
+
+	// The callbacks may have moved the Components, so they are found again
+	if constexpr (Initializable<Component>)
+	{
+		for (size_t i{}; i < amount; ++i)
+			m_References[m_EntitySet.Find(ids[i])]->m_ptr->Initialize(GetRegistry());
+	}
+}
+
 template <typename Component>
 void* TypeView<Component>::AddAfterUpdate_void(entityId id)
 {
@@ -595,51 +884,66 @@ VoidIterator TypeView<T>::GetVoidIteratorEnd()
 }
 
 template <typename T>
-Reference<T> TypeView<T>::AddMap(entityId id, T* data)
+Reference<T> TypeView<T>::AddMap(entityId id)
 {
-	size_t pos = GetPositionInArray(data);
+	auto reference = new (m_ReferencePool.allocate()) ReferencePointer<T>(&m_Data.back());
 
-	auto reference = m_ReferencePool.allocate();
-	reference->m_ptr = data;
+	m_References.emplace_back(reference);
+	size_t pos{ m_EntitySet.push_back(id) };
+	m_Ticks.push_back(GetCurrentTick());
+	++m_Version;
 
-	// insert into entity data map
-	m_EntityDataReferences.emplace(id, reference);
-
-	// insert into data entity map
-	CheckDataEntityMap(pos);
-	m_DataEntityMap[pos] = id;
+	// keep the inactive elements at the back of the array
+	if (m_InactiveItems)
+	{
+		const size_t firstInactive{ GetSize() - 1 - m_InactiveItems };
+		SwapPositions(firstInactive, pos);
+	}
 
 	return Reference<T>(reference);
 }
 
 template <typename T>
-void TypeView<T>::ResizeDataEntityMap(size_t size)
+void TypeView<T>::ResizeData()
 {
-	m_DataEntityMap.resize(size, Entity::InvalidId);
+	ResizeData(m_Data.empty() ? 4 : (m_Data.size() * 2));
 }
 
 template <typename T>
-void TypeView<T>::CheckDataEntityMap(size_t size)
+void TypeView<T>::ResizeData(size_t capacity)
 {
-	if (size >= m_DataEntityMap.size())
+	m_Data.reserve(capacity);
+	m_References.reserve(m_Data.capacity());
+	m_EntitySet.reserve(m_Data.capacity());
+	m_Ticks.reserve(m_Data.capacity());
+
+	// Paged Components never move when the array grows
+	if constexpr (!PagedStorable<T>)
 	{
-		ResizeDataEntityMap(size * 2);
+		const size_t size{ m_Data.size() };
+		for (size_t i{}; i < size; ++i)
+		{
+			m_References[i]->m_ptr = &m_Data[i];
+		}
 	}
 }
 
 template <typename T>
-void TypeView<T>::ResizeData()
+typename TypeView<T>::Storage TypeView<T>::CreateStorage()
 {
-	T* originalLoc = m_Data.data();
-	m_Data.reserve(m_Data.empty() ? 4 : (m_Data.size() * 2));
-	T* newLoc = m_Data.data();
-
-	const int64_t difference = reinterpret_cast<int8_t*>(newLoc) - reinterpret_cast<int8_t*>(originalLoc);
+	if constexpr (PagedStorable<T>)
+		return Storage(size_t(T::MaxComponents));
+	else
+		return Storage(ComponentAllocatorType<T>::Create());
+}
 
-	for (auto& reference : m_EntityDataReferences)
-	{
-		reference.second->m_ptr = reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(reference.second->m_ptr) + difference);
-	}
+template <typename T>
+typename TypeView<T>::ReferenceArray TypeView<T>::CreateReferenceArray()
+{
+	if constexpr (PagedStorable<T>)
+		return ReferenceArray(size_t(T::MaxComponents));
+	else
+		return ReferenceArray();
 }
 
 template <typename T>
@@ -654,20 +958,40 @@ void TypeView<T>::CheckDataSize()
 template <typename T>
 void TypeView<T>::SwapRemove(size_t pos)
 {
-	m_Data[pos] = m_Data.back();
-	m_Data.pop_back();
-	
-	ChangeMapping(m_Data.size(), pos);
+	const size_t activeAmount{ GetActiveAmount() };
+	if (pos < activeAmount)
+	{
+		// Move the element to the last active position and then swap it with the last element.
+		// This moves the first inactive element to the last active position so all inactive elements stay at the back
+		SwapPositions(pos, activeAmount - 1);
+		SwapPositions(activeAmount - 1, GetSize() - 1);
+	}
+	else
+	{
+		SwapPositions(pos, GetSize() - 1);
+		--m_InactiveItems;
+	}
+
+	PopBack();
 }
 
 template <typename T>
-void TypeView<T>::ChangeMapping(size_t oldPosArray, size_t newPosArray)
+void TypeView<T>::PopBack()
 {
-	entityId id = m_DataEntityMap[oldPosArray];
-	m_DataEntityMap[newPosArray] = id;
-	m_DataEntityMap[oldPosArray] = Entity::InvalidId;
+	auto reference = m_References.back();
+	reference->m_ptr = nullptr;
 
-	m_EntityDataReferences[id]->m_ptr = m_Data.data() + newPosArray;
+	// deallocate if no references to the element exists
+	if (reference->GetReferencesAmount() == 0)
+		m_ReferencePool.deallocate(reference);
+	else
+		m_PendingDeleteReferences.push_back(reference);
+
+	m_Data.pop_back();
+	m_References.pop_back();
+	m_EntitySet.pop_back();
+	m_Ticks.pop_back();
+	++m_Version;
 }
 
 template <typename T>
@@ -685,10 +1009,7 @@ void TypeView<T>::SetViewDataFlag(ViewDataFlag flag)
 	case ViewDataFlag::invalid:
 		if constexpr (Sortable<T>)
 		{
-			volatile SortingProgress progress{};
-			const volatile bool quit{};
-			SortData(progress, quit);
-			m_DataFlag = ViewDataFlag::valid;
+			SortData();
 		}
 		else
 		{
@@ -706,77 +1027,77 @@ void TypeView<T>::SwapPositions(size_t pos0, size_t pos1)
 	if (pos0 == pos1) return;
 
 	std::swap(m_Data[pos0], m_Data[pos1]);
-	std::swap(m_EntityDataReferences[pos0]->m_ptr, m_EntityDataReferences[pos1]->m_ptr);
-	std::swap(m_DataEntityMap[pos0], m_DataEntityMap[pos1]);
+	std::swap(m_References[pos0], m_References[pos1]);
+	m_References[pos0]->m_ptr = &m_Data[pos0];
+	m_References[pos1]->m_ptr = &m_Data[pos1];
+	m_EntitySet.SwapPositions(pos0, pos1);
+	m_Ticks.SwapPositions(pos0, pos1);
+	++m_Version;
+
+	for (auto& callback : OnElementMove)
+	{
+		callback(this, m_EntitySet[pos0], pos0);
+		callback(this, m_EntitySet[pos1], pos1);
+	}
 
 	SetViewDataFlag(ViewDataFlag::dirty);
 }
 
 template <typename T>
-void TypeView<T>::SortData(volatile SortingProgress& sortingProgress, const volatile bool& quit)
+void TypeView<T>::SortData()
 {
-	try
-	{
-		sortingProgress = SortingProgress::sorting;
-
-		size_t size = m_Data.size();
-		auto DataCopy = std::unique_ptr<T[]>(new T[size]);
-		auto newEntityMapping = std::unique_ptr<entityId[]>(new entityId[size]);
-
-		std::memcpy(DataCopy.get(), m_Data.data(), size * sizeof(T));
-		std::memcpy(newEntityMapping.get(), m_DataEntityMap.data(), size * sizeof(entityId));
-
-		m_DataFlag = ViewDataFlag::sorting;
-
-		SmoothSort(DataCopy.get(), newEntityMapping.get(), m_DataFlag, size);
-
-		if (m_DataFlag == ViewDataFlag::sorting) // in case the data flag changed to dirty while sorting
-		{
-			sortingProgress = SortingProgress::done;
+	const size_t size{ m_Data.size() };
 
-			auto entityCopyBuffer = std::unique_ptr<T*[]>(new T*[size]);
+	// Only the active elements are sorted, the inactive elements have to stay at the back.
+	// The elements of the owning group keep the order of the group at the front
+	const size_t grouped{ m_GroupedAmount };
+	auto newEntityMapping = std::unique_ptr<entityId[]>(new entityId[size]);
+	std::memcpy(newEntityMapping.get(), m_EntitySet.data(), size * sizeof(entityId));
 
-			while (sortingProgress != SortingProgress::copying)
-			{
-				if (quit)
-					return;
-			}
-
-			std::memcpy(m_Data.data(), DataCopy.get(), sizeof(T) * size);
-
-			for (size_t i{}; i < size; ++i)
-			{
-				auto newId{ newEntityMapping[i] };
-				entityCopyBuffer[i] = m_EntityDataReferences[newId]->m_ptr;
-			}
-
-			for (size_t i{}; i < size; ++i)
-			{
-				auto oldId{ m_DataEntityMap[i] };
-				m_EntityDataReferences[oldId]->m_ptr = entityCopyBuffer[i];
-			}
+	m_DataFlag = ViewDataFlag::sorting;
 
-			sortingProgress = SortingProgress::none;
-			m_DataFlag = ViewDataFlag::valid;
-		}
-		else
-		{
-			sortingProgress = SortingProgress::canceled;
-		}
+	try
+	{
+		// The elements are swapped in place, the entity mapping is swapped with them
+		SmoothSort(m_Data.data() + grouped, newEntityMapping.get() + grouped, m_DataFlag, GetActiveAmount() - grouped);
 	}
 	catch (const std::exception& e)
 	{
 		std::cerr << e.what();
-		sortingProgress = SortingProgress::canceled;
 	}
+
+	// Reorder the references and change ticks to the new positions of their entities
+	auto referenceCopyBuffer = std::unique_ptr<ReferencePointer<T>*[]>(new ReferencePointer<T>*[size]);
+	auto tickOrder = std::unique_ptr<size_t[]>(new size_t[size]);
+	for (size_t i{}; i < size; ++i)
+	{
+		const size_t oldPos{ m_EntitySet.Find(newEntityMapping[i]) };
+		referenceCopyBuffer[i] = m_References[oldPos];
+		referenceCopyBuffer[i]->m_ptr = &m_Data[i];
+		tickOrder[oldPos] = i;
+	}
+	std::memcpy(m_References.data(), referenceCopyBuffer.get(), sizeof(ReferencePointer<T>*) * size);
+	m_Ticks.Reorder(tickOrder.get());
+
+	m_EntitySet.Assign(newEntityMapping.get(), size);
+	++m_Version;
+
+	// Views of different types are sorted concurrently, the callbacks may only modify data of this type
+	for (auto& callback : OnElementMove)
+	{
+		for (size_t i{}; i < size; ++i)
+			callback(this, m_EntitySet[i], i);
+	}
+
+	if (m_DataFlag == ViewDataFlag::sorting)
+		m_DataFlag = ViewDataFlag::valid;
 }
 
 template <typename T>
 size_t TypeView<T>::GetPositionInArray(entityId id) const
 {
-	assert(m_EntityDataReferences.contains(id));
-	auto ref = m_EntityDataReferences.find(id);
-	return GetPositionInArray(ref->second->m_ptr);
+	assert(Contains(id));
+	return m_EntitySet.Find(id);
 }
 
 template <typename T>
@@ -785,3 +1106,9 @@ size_t TypeView<T>::GetPositionInArray(const T* data) const
 	assert(data <= &m_Data.back() && data >= &m_Data.front());
 	return data - &m_Data.front();
 }
+
+// Empty Components are stored as a set of entities only
+#include "TagView.h"
+
+// Components opting into column storage store every registered member variable in its own array
+#include "ColumnView.h"
@@ -1,11 +1,17 @@
 ﻿#pragma once
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <span>
 #include <vector>
 
 #include "../Entity/Entity.h"
 #include "../DataAccess/References.h"
 #include "../DataAccess/Iterators.h"
+#include "../DataAccess/SparseSet.h"
+#include "../DataAccess/ChangeTicks.h"
 
 enum class ViewDataFlag : uint8_t
 {
@@ -17,12 +23,12 @@ enum class ViewDataFlag : uint8_t
 
 	/**
 	 * The array has become unsorted but does not need an immediate sort of its elements.
-	 * The array will be sorted on a different thread and be replaced by the newly sorted one when done sorting
+	 * The array will be sorted at the start of the next Update of the registry, on the job system together with the other unsorted arrays
 	 */
 	dirty,
 
 	/**
-	 * The array data is being sorted on a different thread and can be interrupted by setting the flag to dirty.
+	 * The array data is being sorted and can be interrupted by setting the flag to dirty.
 	 */
 	sorting,
 
@@ -32,15 +38,6 @@ enum class ViewDataFlag : uint8_t
 	invalid,
 };
 
-enum class SortingProgress : uint8_t
-{
-	none,
-	sorting,
-	canceled,
-	done,
-	copying
-};
-
 struct TypeViewInfo
 {
 	uint32_t typeId;
@@ -51,11 +48,31 @@ struct TypeViewInfo
 	size_t inactiveAmount;
 };
 
+/**
+ * The state of a view at the time a snapshot was taken (see EntityRegistry::TakeSnapshot).
+ * Snapshots of views that did not change since the previous snapshot share its ViewSnapshot instead of copying the view again.
+ */
+struct ViewSnapshot
+{
+	virtual ~ViewSnapshot() = default;
+
+	std::vector<entityId> entities;
+	size_t inactiveAmount{};
+	size_t groupedAmount{};
+	ViewDataFlag dataFlag{ ViewDataFlag::valid };
+
+	/** The version of the view and the change tick of the registry at the time the snapshot was taken*/
+	uint32_t version{};
+	ChangeTicks::Tick tick{};
+};
+
 class EntityRegistry;
+class TypeBinding;
 
 class TypeViewBase
 {
 	friend class EntityRegistry;
+	friend class TypeBinding;
 
 public:
 
@@ -69,12 +86,15 @@ public:
 
 	EntityRegistry* GetRegistry() const { return m_pRegistry; }
 
+	/** The dense index of the view inside of its registry, used as the bit of the view inside of the signatures of the entities*/
+	size_t GetViewIndex() const { return m_ViewIndex; }
+
 public:
 
 	/** Misc*/
 
 	virtual void Update(float deltaTime) = 0;
-	virtual void SortData(volatile SortingProgress& sortingProgress, const volatile bool& quit) = 0;
+	virtual void SortData() = 0;
 	virtual void SerializeView(std::ostream& stream) = 0;
 	virtual void DeserializeView(std::istream& stream) = 0;
 	virtual void PrintType(std::ostream& stream) = 0;
@@ -83,12 +103,32 @@ public:
 
 	/** Entities*/
 
-	const std::vector<entityId>& GetRegisteredEntities() const { return m_DataEntityMap; }
+	/** Returns the entities inside of the view. The position of an entity is the same as the position of its Component in the data array*/
+	std::span<const entityId> GetRegisteredEntities() const { return m_EntitySet.GetEntities(); }
 
-	virtual bool Contains(entityId id) = 0;
+	bool Contains(entityId id) const { return m_EntitySet.contains(id); }
+
+	/** Returns the position of the Component of the entity inside of the data array*/
+	size_t GetPosition(entityId id) const { return m_EntitySet.Find(id); }
 	virtual entityId GetEntityId(const void* elementAddress) = 0;
 	virtual VoidReference AddEntity(entityId id) = 0;
 
+	/** Adds a Component to the entity by moving the given Component into the view*/
+	virtual VoidReference AddEntity(entityId id, void* component) = 0;
+
+	/**
+	 * Adds a copy of the Component to every one of the entities, used to instantiate prefabs.
+	 * The view grows at most once and OnElementsAdd is called once after all the Components were added.
+	 */
+	virtual void AddEntities(const entityId* ids, size_t amount, const void* component) = 0;
+
+	/**
+	 * Moves the Components of the entities into the view of the same type inside of a different registry, where they belong to targetIds[i].
+	 * The target grows at most once and is only notified after all the Components were added. Disabled Components stay disabled.
+	 * The Components are left moved-from inside of this view, the caller removes the entities afterwards.
+	 */
+	virtual void MoveEntities(const entityId* ids, size_t amount, TypeViewBase& target, const entityId* targetIds) = 0;
+
 	/** Enabling/Disabling*/
 
 	virtual void Enable(entityId id) = 0;
@@ -105,6 +145,10 @@ public:
 	virtual VoidIterator GetVoidIterator() = 0;
 	virtual VoidIterator GetVoidIteratorEnd() = 0;
 
+	/** Returns the start of the data array, the Component of an entity is at GetPosition(id) * GetElementSize() bytes from the start*/
+	virtual void* GetVoidData() = 0;
+	virtual size_t GetElementSize() const = 0;
+
 	/** Data Modifiers*/
 
 	virtual void Remove(entityId id) = 0;
@@ -121,30 +165,159 @@ public:
 
 	virtual void* AddAfterUpdate_void(entityId id) = 0;
 
-	size_t GetSize() const
+	size_t GetSize() const { return m_EntitySet.size(); }
+
+	/** Owning groups*/
+
+	/** Returns the TypeBinding that owns this view, nullptr if the view is not owned*/
+	const TypeBinding* GetOwner() const { return m_pOwner; }
+
+	/** The amount of elements at the front of the data array that belong to the owning group*/
+	size_t GetGroupedAmount() const { return m_GroupedAmount; }
+
+	/** Change detection*/
+
+	/** The ticks at which the Components were added and last changed, stored at the same positions as the Components*/
+	const ChangeTicks& GetChangeTicks() const { return m_Ticks; }
+
+	/** The current change tick of the registry, 0 for views without a registry*/
+	ChangeTicks::Tick GetCurrentTick() const { return m_pChangeTick ? m_pChangeTick->load(std::memory_order_relaxed) : 0; }
+
+	/**
+	 * Marks the Component of the entity as changed at the current tick of the registry.
+	 * The registry marks all the Components a system may write to after the system executed (see MarkAllChanged()),
+	 * writes made outside of systems are not detected, a Component only counts as changed for a Changed<> query after calling this.
+	 */
+	void MarkChanged(entityId id)
 	{
-		const size_t size = m_DataEntityMap.size();
-		for (size_t i{}; i < size; ++i)
-		{
-			if (m_DataEntityMap[size - 1 - i] != Entity::InvalidId)
-				return size - i;
-		}
-		return 0;
+		const size_t pos{ m_EntitySet.Find(id) };
+		assert(pos != SparseSet::InvalidPos);
+		m_Ticks.SetChanged(pos, GetCurrentTick());
 	}
 
+	/**
+	 * Marks every Component as changed at the current tick of the registry.
+	 * Called by the registry for the Components in the write access of a system after it executed, as the system writes through references.
+	 */
+	void MarkAllChanged() { m_Ticks.SetAllChanged(GetCurrentTick()); }
+
+	/** Snapshots*/
+
+	/**
+	 * Copies the entities and Components into the snapshot, trivially copyable Components are copied as a single block.
+	 * When the view did not change since previous was taken, the snapshot shares previous instead.
+	 * The memory of the snapshot is reused unless it is still shared with a different snapshot.
+	 * @throws std::runtime_error: when the Component is not copyable
+	 */
+	virtual void TakeSnapshot(std::shared_ptr<ViewSnapshot>& snapshot, const std::shared_ptr<ViewSnapshot>& previous, ChangeTicks::Tick tick) = 0;
+
+	/**
+	 * Replaces the entities and Components by the ones of the snapshot, or removes all of them when snapshot is nullptr.
+	 * Components of entities that exist in both states keep their References, the References of the other Components become invalid.
+	 * No callbacks are called, the registry updates the signatures and the bindings afterwards.
+	 * The restored Components count as changed now, and as added now when the entities of the view changed.
+	 */
+	virtual void RestoreSnapshot(const ViewSnapshot* snapshot) = 0;
+
+	/**
+	 * Copies the Components of the snapshot back without touching the entities, used for the views that are unchanged since the snapshot.
+	 * Writes made outside of systems without MarkChanged are not found by IsUnchangedSince, so trivially copyable Components are always copied back.
+	 * Does nothing for Components that are not trivially copyable. The copied Components count as changed now.
+	 */
+	virtual void RestoreData(const ViewSnapshot& snapshot) = 0;
+
+	/**
+	 * Returns true if no entity was added, removed or moved and no Component was marked as changed since the snapshot was taken.
+	 * Components written to by a system are marked, other writes without MarkChanged are not detected.
+	 */
+	bool IsUnchangedSince(const ViewSnapshot& snapshot) const;
+
+	/** Increased whenever an entity is added, removed, moved, enabled or disabled*/
+	uint32_t GetVersion() const { return m_Version; }
+
 public:
 
 	std::vector<std::function<void(TypeViewBase*, entityId)>> OnElementAdd;
+
+	/**
+	 * Called once with all the entities of a batch after their Components were added (AddEntities, MoveEntities and adding a span of Components).
+	 * Batches do not call OnElementAdd, listeners that track every added Component use both.
+	 */
+	std::vector<std::function<void(TypeViewBase*, std::span<const entityId>)>> OnElementsAdd;
 	
 	std::vector<std::function<void(TypeViewBase*, entityId)>> OnElementRemove;
 
+	/** Called with the new position of the entity whenever its Component moved to a different position in the data array*/
+	std::vector<std::function<void(TypeViewBase*, entityId, size_t)>> OnElementMove;
+
+	/** Called before the Component of the entity is disabled*/
+	std::vector<std::function<void(TypeViewBase*, entityId)>> OnElementDisable;
+
+	/** Called after the Component of the entity is enabled*/
+	std::vector<std::function<void(TypeViewBase*, entityId)>> OnElementEnable;
+
 protected:
 
-	std::vector<entityId> m_DataEntityMap{ 16,Entity::InvalidId };
+	/** Swaps the Components at the given positions, used by the owning group to pack its entities at the front*/
+	virtual void SwapElements(size_t pos0, size_t pos1) = 0;
+
+	/** Keeps the entities and the change ticks in PagedArrays of maxSize elements, so they never move either. The view has to be empty*/
+	void SetMaxSize(size_t maxSize)
+	{
+		m_EntitySet.SetMaxSize(maxSize);
+		m_Ticks.SetMaxSize(maxSize);
+	}
+
+	/** Copies the entities and the state of the view shared by all Component types into the snapshot*/
+	void WriteSnapshot(ViewSnapshot& snapshot, size_t inactiveAmount, ChangeTicks::Tick tick) const
+	{
+		snapshot.entities.assign(m_EntitySet.begin(), m_EntitySet.end());
+		snapshot.inactiveAmount = inactiveAmount;
+		snapshot.groupedAmount = m_GroupedAmount;
+		snapshot.dataFlag = m_DataFlag;
+		snapshot.version = m_Version;
+		snapshot.tick = tick;
+	}
+
+	/** Returns true if the entities of the view are the entities of the snapshot, at the same positions*/
+	bool HasEntitiesOf(const ViewSnapshot* snapshot) const
+	{
+		if (!snapshot)
+			return m_EntitySet.empty();
+		return std::equal(snapshot->entities.begin(), snapshot->entities.end(), m_EntitySet.begin(), m_EntitySet.end());
+	}
+
+protected:
+
+	/** Maps the entities to the position of their Component in the data array and vice versa*/
+	SparseSet m_EntitySet;
 
 	EntityRegistry* m_pRegistry{};
+	size_t m_ViewIndex{};
 
 	ViewDataFlag m_DataFlag{ ViewDataFlag::valid };
 	uint16_t m_DataFlagId{ 1 };
-	
-};
\ No newline at end of file
+
+	/** The owning group keeps its entities at the positions [0, m_GroupedAmount) in the same order in all of its views*/
+	const TypeBinding* m_pOwner{};
+	size_t m_GroupedAmount{};
+
+	ChangeTicks m_Ticks;
+	const std::atomic<ChangeTicks::Tick>* m_pChangeTick{};
+
+	uint32_t m_Version{};
+
+};
+
+inline bool TypeViewBase::IsUnchangedSince(const ViewSnapshot& snapshot) const
+{
+	if (snapshot.version != m_Version || snapshot.entities.size() != GetSize() || snapshot.groupedAmount != m_GroupedAmount)
+		return false;
+
+	for (size_t chunk{}; chunk < ChangeTicks::GetChunkAmount(m_Ticks.size()); ++chunk)
+	{
+		if (m_Ticks.GetChunkChanged(chunk) > snapshot.tick)
+			return false;
+	}
+	return true;
+}
\ No newline at end of file
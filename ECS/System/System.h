@@ -2,6 +2,8 @@
 #include "SystemBase.h"
 #include "../Registry/TypeView.h"
 #include "../Registry/TypeBinding.h"
+#include "../Registry/ArchetypeStorage.h"
+#include "../Registry/Observer.h"
 #include "../TypeInformation/Concepts.h"
 
 
@@ -13,14 +15,15 @@ template <typename Components>
 class ViewSystem : public SystemBase
 {
 public:
-	using ComponentType = Components;
+	/** The Component may be const to mark that the system only reads it*/
+	using ComponentType = std::remove_const_t<Components>;
 
 public:
 
 	ViewSystem(const SystemParameters& parameters) : SystemBase(parameters) {}
 
-	TypeView<Components>* GetTypeView() const { return m_TypeView; }
-	void SetTypeView(TypeView<Components>* view) { m_TypeView = view; }
+	TypeView<ComponentType>* GetTypeView() const { return m_TypeView; }
+	void SetTypeView(TypeView<ComponentType>* view) { m_TypeView = view; }
 
 	constexpr uint32_t GetTypeId() const { return m_TypeView->GetTypeId(); }
 	const std::string& GetTypeName() const { return TypeInformation::GetTypeName(GetTypeId()); }
@@ -33,9 +36,15 @@ public:
 
 	bool IsSubSystem(uint32_t baseId) override {return TypeInformation::IsSubClass(baseId, GetTypeId());}
 
+	SystemAccess GetAccess() override
+	{
+		const uint32_t typeId{ GetTypeId() };
+		return SystemAccess::Create<Components>(&typeId);
+	}
+
 protected:
 
-	TypeView<Components>* m_TypeView{};
+	TypeView<ComponentType>* m_TypeView{};
 
 };
 
@@ -79,15 +88,131 @@ public:
 		return false;
 	}
 
+	/** Uses the types of the binding, which are different from the Components in case of a sub system*/
+	SystemAccess GetAccess() override { return SystemAccess::Create<Components...>(m_Binding->GetTypeIds()); }
+
 protected:
 
 	TypeBinding* m_Binding{};
 
 };
 
+/**
+ * ArchetypeSystem is a system that acts on all entities containing the given Components when the registry uses StorageMode::Archetypes.
+ * It owns an ArchetypeQuery that iterates the chunks of the matching Archetypes and can be accessed using the GetArchetypeQuery() method.
+ * Sub classes of the Components are matched by the query, so no sub systems are needed.
+ */
+template <typename... Components>
+class ArchetypeSystem : public SystemBase
+{
+	static_assert(sizeof...(Components) >= 1);
+
+public:
+	ArchetypeSystem(const SystemParameters& parameters) : SystemBase(parameters) {}
+
+	ArchetypeQuery* GetArchetypeQuery() const { return m_Query.get(); }
+	void SetArchetypeStorage(const ArchetypeStorage& storage)
+	{
+		constexpr auto types = GetTypes();
+		m_Query = std::make_unique<ArchetypeQuery>(storage, types.data(), types.size());
+	}
+
+	static constexpr std::array<uint32_t, sizeof...(Components)> GetTypes() { return { reflection::type_id<Components>()... }; }
+
+	size_t GetEntityAmount() override { return m_Query->GetEntityAmount(); }
+	void PrintTypes(std::ostream& stream) override
+	{
+		for (uint32_t typeId : GetTypes())
+			stream << '[' << typeId << ']';
+	}
+
+	/** Slower then GetTypes*/
+	std::vector<uint32_t> GetTypeIds() override
+	{
+		constexpr auto ids = GetTypes();
+		return std::vector<uint32_t>{ ids.begin(), ids.end() };
+	}
+
+	bool IsSubSystem(uint32_t) override { return false; }
+
+	SystemAccess GetAccess() override
+	{
+		constexpr auto ids = GetTypes();
+		return SystemAccess::Create<Components...>(ids.data());
+	}
+
+protected:
+
+	std::unique_ptr<ArchetypeQuery> m_Query;
+
+};
+
+/**
+ * ReactiveSystemBase is a system that reacts to the entities a Component was added to or removed from since its previous execution.
+ * The entities are collected by an ObserverStorage of the registry and passed to React() in one batch, after which the storage is cleared.
+ * The views of sub classes of the Component are observed by the same storage, so no sub systems are needed.
+ * The entities passed to React() may no longer have the Component or may have been removed.
+ */
+class ReactiveSystemBase : public SystemBase
+{
+public:
+	ReactiveSystemBase(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event)
+		: SystemBase(parameters), m_TypeId(typeId), m_Event(event) {}
+
+	/** Called with the collected entities when at least one entity was collected*/
+	virtual void React(std::span<const entityId> entities) = 0;
+
+	void Execute() override final
+	{
+		if (m_pObserver->empty())
+			return;
+
+		React(m_pObserver->GetEntities());
+		m_pObserver->clear();
+	}
+
+	uint32_t GetObservedTypeId() const { return m_TypeId; }
+	ObserverEvent GetObservedEvent() const { return m_Event; }
+
+	ObserverStorage* GetObserver() const { return m_pObserver; }
+	void SetObserver(ObserverStorage* observer) { m_pObserver = observer; }
+
+	/** The view of the observed Component, used to access the Components and the registry*/
+	TypeViewBase* GetTypeView() const { return m_pTypeView; }
+	void SetTypeView(TypeViewBase* view) { m_pTypeView = view; }
+
+	size_t GetEntityAmount() override { return m_pObserver->size(); }
+	void PrintTypes(std::ostream& stream) override { m_pTypeView->PrintType(stream); }
+	std::vector<uint32_t> GetTypeIds() override { return std::vector<uint32_t>{ { m_TypeId } }; }
+	bool IsSubSystem(uint32_t) override { return false; }
+
+private:
+
+	uint32_t m_TypeId;
+	ObserverEvent m_Event;
+
+	ObserverStorage* m_pObserver{};
+	TypeViewBase* m_pTypeView{};
+
+};
+
+/**
+ * Reactive system observing the given Component, which can be registered using RegisterSystem like any other system.
+ * Override React() to handle the collected entities.
+ */
+template <typename Component, ObserverEvent Event = ObserverEvent::Add>
+class ReactiveSystem : public ReactiveSystemBase
+{
+public:
+	ReactiveSystem(const SystemParameters& parameters) : ReactiveSystemBase(parameters, reflection::type_id<Component>(), Event) {}
+
+	TypeView<Component>* GetTypeView() const { return static_cast<TypeView<Component>*>(ReactiveSystemBase::GetTypeView()); }
+};
+
 /**
  * View System that can be initialized using a function taking the reference of the component.
  * This will call the function on every component when the Execute() method is called.
+ * The components are split over the workers of the job system when the system parameters are marked parallel.
  */
 template <typename Component>
 class ViewSystemDynamic final : public ViewSystem<Component>
@@ -97,8 +222,12 @@ public:
 
 	void Execute() override
 	{
-		for (auto& element : *ViewSystem<Component>::m_TypeView)
-			m_ExecutingFunction(element);
+		auto view = ViewSystem<Component>::m_TypeView;
+		SystemBase::ForEachChunk(view->GetData(), view->GetElementSize(), view->GetActiveAmount(), [this, view](size_t begin, size_t end)
+			{
+				for (auto it{ view->begin() + begin }, last{ view->begin() + end }; it != last; ++it)
+					m_ExecutingFunction(*it);
+			});
 	}
 
 private:
@@ -117,8 +246,13 @@ public:
 
 	void Execute() override
 	{
-		for (auto& element : *ViewSystem<Component>::m_TypeView)
-			m_ExecutingFunction(SystemBase::GetDeltaTime(), element);
+		auto view = ViewSystem<Component>::m_TypeView;
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		SystemBase::ForEachChunk(view->GetData(), view->GetElementSize(), view->GetActiveAmount(), [this, view, deltaTime](size_t begin, size_t end)
+			{
+				for (auto it{ view->begin() + begin }, last{ view->begin() + end }; it != last; ++it)
+					m_ExecutingFunction(deltaTime, *it);
+			});
 	}
 
 private:
@@ -129,6 +263,7 @@ private:
 /**
  * Binding system that can be initialized using a function taking the references of the components.
  * This will call the function on every element of the TypeBinding when the Execute() method is called.
+ * The elements are split over the workers of the job system when the system parameters are marked parallel.
  */
 template <typename... Components>
 class BindingSystemDynamic final : public BindingSystem<Components...>
@@ -138,7 +273,11 @@ public:
 
 	void Execute() override
 	{
-		BindingSystem<Components...>::m_Binding->ApplyFunctionOnAll(m_ExecutingFunction);
+		auto binding = BindingSystem<Components...>::m_Binding;
+		SystemBase::ForEachChunk(binding->GetIndices(), binding->GetElementStride(), binding->GetSize(), [this, binding](size_t begin, size_t end)
+			{
+				binding->ApplyFunctionOnRange(m_ExecutingFunction, begin, end);
+			});
 	}
 
 private:
@@ -158,11 +297,193 @@ public:
 
 	void Execute() override
 	{
-		BindingSystem<Components...>::m_Binding->ApplyFunctionOnAllDT(m_ExecutingFunction, SystemBase::GetDeltaTime());
+		auto binding = BindingSystem<Components...>::m_Binding;
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		SystemBase::ForEachChunk(binding->GetIndices(), binding->GetElementStride(), binding->GetSize(), [this, binding, deltaTime](size_t begin, size_t end)
+			{
+				binding->ApplyFunctionOnRangeDT(m_ExecutingFunction, begin, end, deltaTime);
+			});
 	}
 
 private:
 
 	std::function<void(float, Components&...)> m_ExecutingFunction;
 
-};
\ No newline at end of file
+};
+
+/**
+ * Archetype system that can be initialized using a function taking the references of the components.
+ * This will call the function on every entity matching the ArchetypeQuery when the Execute() method is called.
+ */
+template <typename... Components>
+class ArchetypeSystemDynamic final : public ArchetypeSystem<Components...>
+{
+public:
+	ArchetypeSystemDynamic(const SystemParameters& parameters, const std::function<void(Components&...)>& function) : ArchetypeSystem<Components...>(parameters), m_ExecutingFunction(function) {}
+
+	void Execute() override
+	{
+		ArchetypeSystem<Components...>::m_Query->template ForEach<Components...>(m_ExecutingFunction);
+	}
+
+private:
+
+	std::function<void(Components&...)> m_ExecutingFunction;
+
+};
+
+/**
+ * Same as ArchetypeSystemDynamic but the first parameter is deltaTime
+ */
+template <typename... Components>
+class ArchetypeSystemDynamicDT final : public ArchetypeSystem<Components...>
+{
+public:
+	ArchetypeSystemDynamicDT(const SystemParameters& parameters, const std::function<void(float, Components&...)>& function) : ArchetypeSystem<Components...>(parameters), m_ExecutingFunction(function) {}
+
+	void Execute() override
+	{
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		ArchetypeSystem<Components...>::m_Query->template ForEach<Components...>([this, deltaTime](Components&... components)
+			{
+				m_ExecutingFunction(deltaTime, components...);
+			});
+	}
+
+private:
+
+	std::function<void(float, Components&...)> m_ExecutingFunction;
+
+};
+/**
+ * View System that calls a function object of any type, like a lambda, on every component.
+ * Unlike ViewSystemDynamic the type of the function is known, so the call can be inlined and the loop vectorized.
+ * The function may take deltaTime as its first parameter.
+ */
+template <typename Function, typename Component>
+class ViewSystemCallable final : public ViewSystem<Component>
+{
+public:
+	ViewSystemCallable(const SystemParameters& parameters, const Function& function) : ViewSystem<Component>(parameters), m_ExecutingFunction(function) {}
+
+	void Execute() override
+	{
+		using ComponentType = typename ViewSystem<Component>::ComponentType;
+
+		auto view = ViewSystem<Component>::m_TypeView;
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		SystemBase::ForEachChunk(view->GetData(), view->GetElementSize(), view->GetActiveAmount(), [this, view, deltaTime](size_t begin, size_t end)
+			{
+				// Views of sub classes have bigger elements and have to be iterated using their element size
+				if (view->GetElementSize() == sizeof(ComponentType))
+				{
+					ComponentType* data{ view->GetData() };
+					for (size_t i{ begin }; i < end; ++i)
+						Call(deltaTime, data[i]);
+				}
+				else
+				{
+					for (auto it{ view->begin() + begin }, last{ view->begin() + end }; it != last; ++it)
+						Call(deltaTime, *it);
+				}
+			});
+	}
+
+private:
+
+	void Call(float deltaTime, Component& component)
+	{
+		if constexpr (std::is_invocable_v<Function&, Component&>)
+			m_ExecutingFunction(component);
+		else
+			m_ExecutingFunction(deltaTime, component);
+	}
+
+	Function m_ExecutingFunction;
+};
+
+/**
+ * Binding System that calls a function object of any type, like a lambda, on every element of the TypeBinding.
+ * Unlike BindingSystemDynamic the type of the function is known, so the call can be inlined.
+ * The function may take deltaTime as its first parameter.
+ */
+template <typename Function, typename... Components>
+class BindingSystemCallable final : public BindingSystem<Components...>
+{
+public:
+	BindingSystemCallable(const SystemParameters& parameters, const Function& function) : BindingSystem<Components...>(parameters), m_ExecutingFunction(function) {}
+
+	void Execute() override
+	{
+		auto binding = BindingSystem<Components...>::m_Binding;
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		SystemBase::ForEachChunk(binding->GetIndices(), binding->GetElementStride(), binding->GetSize(), [this, binding, deltaTime](size_t begin, size_t end)
+			{
+				binding->template ApplyCallableOnRange<Components...>([this, deltaTime](Components&... components)
+					{
+						Call(deltaTime, components...);
+					}, begin, end);
+			});
+	}
+
+private:
+
+	void Call(float deltaTime, Components&... components)
+	{
+		if constexpr (std::is_invocable_v<Function&, Components&...>)
+			m_ExecutingFunction(components...);
+		else
+			m_ExecutingFunction(deltaTime, components...);
+	}
+
+	Function m_ExecutingFunction;
+};
+
+/**
+ * Archetype System that calls a function object of any type, like a lambda, on every entity matching the ArchetypeQuery.
+ * Unlike ArchetypeSystemDynamic the type of the function is known, so the call can be inlined and the loop vectorized.
+ * The function may take deltaTime as its first parameter.
+ */
+template <typename Function, typename... Components>
+class ArchetypeSystemCallable final : public ArchetypeSystem<Components...>
+{
+public:
+	ArchetypeSystemCallable(const SystemParameters& parameters, const Function& function) : ArchetypeSystem<Components...>(parameters), m_ExecutingFunction(function) {}
+
+	void Execute() override
+	{
+		const float deltaTime{ SystemBase::GetDeltaTime() };
+		ArchetypeSystem<Components...>::m_Query->template ForEach<Components...>([this, deltaTime](Components&... components)
+			{
+				if constexpr (std::is_invocable_v<Function&, Components&...>)
+					m_ExecutingFunction(components...);
+				else
+					m_ExecutingFunction(deltaTime, components...);
+			});
+	}
+
+private:
+
+	Function m_ExecutingFunction;
+};
+
+/**
+ * Reactive system that calls a function on every collected entity, the observed Component is given by its typeId.
+ */
+class ReactiveSystemDynamic final : public ReactiveSystemBase
+{
+public:
+	ReactiveSystemDynamic(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function)
+		: ReactiveSystemBase(parameters, typeId, event), m_ExecutingFunction(function) {}
+
+	void React(std::span<const entityId> entities) override
+	{
+		EntityRegistry& registry{ *GetTypeView()->GetRegistry() };
+		for (entityId id : entities)
+			m_ExecutingFunction(registry, id);
+	}
+
+private:
+
+	std::function<void(EntityRegistry&, entityId)> m_ExecutingFunction;
+};
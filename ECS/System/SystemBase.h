@@ -1,9 +1,16 @@
 ﻿#pragma once
 #include <string>
 #include <assert.h>
+#include <algorithm>
+#include <array>
 #include <bitset>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 #include "../Registry/TypeViewBase.h"
+#include "../TypeInformation/reflection.h"
+#include "../Jobs/JobSystem.h"
 
 /**
  * named values for execution times used in systems.
@@ -33,21 +40,60 @@ enum class SystemFlags : SystemFlagsType
  * - name: Name of the system. It will register the system as that name and can be added to the registry using the name.
  * - executionTime: When the system should execute compared to other systems. Lower numbers will execute before higher numbers.
  * - updateInterval: The time it takes between each Execute call. 0.f for no interval
+ * - parallel: The function of a dynamic system may be called on different entities concurrently
+ * - minChunkSize: The minimum amount of entities a worker iterates at once when the system is parallel
+ * - readResources/writeResources: The resources of the registry the system accesses (see AddResource())
  */
 struct SystemParameters
 {
+	constexpr static size_t DefaultMinChunkSize{ 1024 };
+
 	/**
 	* @param _name: Name of the system. It will register the system as that name and can be added to the registry using the name.
 	* @param _executionTime: When the system should execute compared to other systems. Lower numbers will execute before higher numbers.
 	* @param _updateInterval: The time it takes between each Execute call. 0.f for no interval
+	* @param _parallel: The function of a dynamic system may be called on different entities concurrently
+	* @param _minChunkSize: The minimum amount of entities a worker iterates at once when the system is parallel
 	*/
-	SystemParameters(const std::string& _name, int32_t _executionTime = int32_t(ExecutionTime::Update), float _updateInterval = 0.f)
-		: name(_name), executionTime(_executionTime), updateInterval(_updateInterval)
+	SystemParameters(const std::string& _name, int32_t _executionTime = int32_t(ExecutionTime::Update), float _updateInterval = 0.f,
+		bool _parallel = false, size_t _minChunkSize = DefaultMinChunkSize)
+		: name(_name), executionTime(_executionTime), updateInterval(_updateInterval), parallel(_parallel), minChunkSize(_minChunkSize)
 	{}
 
 	std::string name;
 	int32_t executionTime = int32_t(ExecutionTime::Update);
 	float updateInterval = 0.f;
+	bool parallel = false;
+	size_t minChunkSize = DefaultMinChunkSize;
+
+	std::vector<uint32_t> readResources;
+	std::vector<uint32_t> writeResources;
+
+	/** Declares a resource of the registry the system accesses, a const resource is only read*/
+	template <typename T>
+	SystemParameters& AddResource()
+	{
+		(std::is_const_v<T> ? readResources : writeResources).emplace_back(reflection::type_id<std::remove_const_t<T>>());
+		return *this;
+	}
+};
+
+/**
+ * The Components a system accesses, used to decide which systems can be executed concurrently (see SystemScheduler.h).
+ * Components that are taken as const are only read, all other Components are written.
+ */
+struct SystemAccess
+{
+	std::vector<uint32_t> readTypes;
+	std::vector<uint32_t> writeTypes;
+
+	/** The typeIds of the resources of the registry, which never conflict with Components*/
+	std::vector<uint32_t> readResources;
+	std::vector<uint32_t> writeResources;
+
+	/** Sorts the typeIds based on the constness of the matching Component*/
+	template <typename... Components>
+	static SystemAccess Create(const uint32_t* typeIds);
 };
 
 /**
@@ -71,14 +117,23 @@ public:
 	virtual std::vector<uint32_t> GetTypeIds	()								= 0;
 	virtual bool IsSubSystem					(uint32_t baseId)				= 0;
 
-	void Update(float DeltaTime)
+	/** The Components read and written by the system. By default all the Components of GetTypeIds() are written*/
+	virtual SystemAccess GetAccess				()								{ return SystemAccess{ {}, GetTypeIds(), {}, {} }; }
+
+	/** GetAccess() together with the resources declared in the parameters of the system, used by the SystemScheduler*/
+	SystemAccess GetSystemAccess();
+
+	/** Executes the system when it is enabled and its update interval passed, returns true if it executed*/
+	bool Update(float DeltaTime)
 	{
 		if (IsEnabled() && (m_AccumulatedTime += DeltaTime) > m_Parameters.updateInterval)
 		{
 			m_DeltaTime = (m_Parameters.updateInterval == 0.f) ? DeltaTime : m_Parameters.updateInterval;
 			Execute();
 			m_AccumulatedTime = (m_Parameters.updateInterval == 0.f) ? 0.f : m_AccumulatedTime - m_Parameters.updateInterval;
+			return true;
 		}
+		return false;
 	}
 
 	void Enable									()								{ SetFlag(SystemFlags::Enabled, true); }
@@ -95,10 +150,78 @@ public:
 	bool GetFlag								(SystemFlags flag)	const		{ return m_Flags[SystemFlagsType(flag)]; }
 	void SetFlag								(SystemFlags flag, bool value)	{ m_Flags[SystemFlagsType(flag)] = value; }
 
+	/** The job system used to iterate parallel systems, set by the registry*/
+	void SetJobSystem							(JobSystem* jobSystem)			{ m_pJobSystem = jobSystem; }
+	JobSystem* GetJobSystem						()					const		{ return m_pJobSystem; }
+
+protected:
+
+	/**
+	 * Calls function(begin, end) on ranges of the elements [0, size).
+	 * When the system is parallel the elements are split in chunks of at least minChunkSize elements that are iterated by different workers.
+	 * Chunks start on a cache line so workers never write to the same cache line.
+	 * @param pData: the first element, used to align the chunks
+	 * @param elementStride: the distance in bytes between two elements
+	 */
+	template <typename Function>
+	void ForEachChunk(const void* pData, size_t elementStride, size_t size, const Function& function);
+
 private:
 
 	SystemParameters							m_Parameters;
-	float										m_DeltaTime;
-	float										m_AccumulatedTime;
+	float										m_DeltaTime{};
+	float										m_AccumulatedTime{};
 	std::bitset<uint8_t(SystemFlags::SIZE)>		m_Flags;
-};
\ No newline at end of file
+	JobSystem*									m_pJobSystem{};
+};
+
+template <typename... Components>
+SystemAccess SystemAccess::Create(const uint32_t* typeIds)
+{
+	constexpr std::array<bool, sizeof...(Components)> isConst{ std::is_const_v<Components>... };
+
+	SystemAccess access{};
+	for (size_t i{}; i < isConst.size(); ++i)
+		(isConst[i] ? access.readTypes : access.writeTypes).emplace_back(typeIds[i]);
+
+	return access;
+}
+
+inline SystemAccess SystemBase::GetSystemAccess()
+{
+	SystemAccess access{ GetAccess() };
+	access.readResources.insert(access.readResources.end(), m_Parameters.readResources.begin(), m_Parameters.readResources.end());
+	access.writeResources.insert(access.writeResources.end(), m_Parameters.writeResources.begin(), m_Parameters.writeResources.end());
+	return access;
+}
+
+template <typename Function>
+void SystemBase::ForEachChunk(const void* pData, size_t elementStride, size_t size, const Function& function)
+{
+	if (!m_Parameters.parallel || !m_pJobSystem || size <= m_Parameters.minChunkSize)
+	{
+		function(size_t{}, size);
+		return;
+	}
+
+	constexpr size_t cacheLineSize{ 64 };
+
+	// Amount of elements after which the elements start on a cache line again, elements without a size (tags) never share a cache line
+	const size_t alignment{ elementStride ? std::lcm(elementStride, cacheLineSize) / elementStride : 1 };
+
+	// The first element that starts on a cache line, the elements before it are part of the first chunk
+	const auto address{ reinterpret_cast<uintptr_t>(pData) };
+	size_t head{};
+	while (head < alignment && (address + head * elementStride) % cacheLineSize != 0)
+		++head;
+	if (head == alignment || head >= size)
+		head = 0;
+
+	const size_t alignedUnits{ (size - head + alignment - 1) / alignment };
+	const size_t grainSize{ (m_Parameters.minChunkSize + alignment - 1) / alignment };
+
+	m_pJobSystem->ParallelFor(0, alignedUnits, grainSize, [head, alignment, size, &function](size_t begin, size_t end)
+		{
+			function(begin == 0 ? size_t{} : head + begin * alignment, std::min(head + end * alignment, size));
+		});
+}
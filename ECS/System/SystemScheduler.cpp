@@ -0,0 +1,92 @@
+#include "SystemScheduler.h"
+
+#include <algorithm>
+
+#include "../TypeInformation/TypeInformation.h"
+
+namespace
+{
+	bool IsSameOrRelatedType(uint32_t type0, uint32_t type1)
+	{
+		return type0 == type1 || TypeInformation::IsSubClass(type0, type1) || TypeInformation::IsSubClass(type1, type0);
+	}
+
+	bool ContainsRelatedType(const std::vector<uint32_t>& types0, const std::vector<uint32_t>& types1)
+	{
+		for (uint32_t type0 : types0)
+			for (uint32_t type1 : types1)
+				if (IsSameOrRelatedType(type0, type1))
+					return true;
+		return false;
+	}
+
+	/** Resources are only the same when their type is the same*/
+	bool ContainsType(const std::vector<uint32_t>& types0, const std::vector<uint32_t>& types1)
+	{
+		for (uint32_t type0 : types0)
+			if (std::find(types1.begin(), types1.end(), type0) != types1.end())
+				return true;
+		return false;
+	}
+}
+
+void SystemScheduler::BuildSchedule(std::vector<SystemBase*>&& systems)
+{
+	m_ScheduledSystems = std::move(systems);
+	m_Batches.clear();
+
+	std::vector<SystemAccess> accesses;
+	accesses.reserve(m_ScheduledSystems.size());
+	for (SystemBase* system : m_ScheduledSystems)
+		accesses.emplace_back(system->GetSystemAccess());
+
+	// Batch index of every system relative to the first batch of its execution time
+	std::vector<size_t> batches(m_ScheduledSystems.size());
+
+	size_t bucketBegin{};
+	while (bucketBegin < m_ScheduledSystems.size())
+	{
+		const int32_t executionTime{ m_ScheduledSystems[bucketBegin]->GetSystemParameters().executionTime };
+
+		size_t bucketEnd{ bucketBegin };
+		while (bucketEnd < m_ScheduledSystems.size() && m_ScheduledSystems[bucketEnd]->GetSystemParameters().executionTime == executionTime)
+			++bucketEnd;
+
+		const size_t firstBatch{ m_Batches.size() };
+		for (size_t i{ bucketBegin }; i < bucketEnd; ++i)
+		{
+			size_t batch{};
+			for (size_t j{ bucketBegin }; j < i; ++j)
+			{
+				if (batches[j] >= batch && Conflicts(accesses[i], accesses[j]))
+					batch = batches[j] + 1;
+			}
+			batches[i] = batch;
+
+			if (firstBatch + batch >= m_Batches.size())
+				m_Batches.resize(firstBatch + batch + 1);
+			m_Batches[firstBatch + batch].emplace_back(m_ScheduledSystems[i]);
+		}
+
+		bucketBegin = bucketEnd;
+	}
+}
+
+bool SystemScheduler::Conflicts(const SystemAccess& access0, const SystemAccess& access1)
+{
+	return ContainsRelatedType(access0.writeTypes, access1.writeTypes)
+		|| ContainsRelatedType(access0.writeTypes, access1.readTypes)
+		|| ContainsRelatedType(access0.readTypes, access1.writeTypes)
+		|| ContainsType(access0.writeResources, access1.writeResources)
+		|| ContainsType(access0.writeResources, access1.readResources)
+		|| ContainsType(access0.readResources, access1.writeResources);
+}
+
+void SystemScheduler::ExecuteBatch(const std::vector<SystemBase*>& batch, const std::function<void(SystemBase*)>& updateSystem)
+{
+	m_pJobSystem->ParallelFor(0, batch.size(), 1, [&batch, &updateSystem](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+				updateSystem(batch[i]);
+		});
+}
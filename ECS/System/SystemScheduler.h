@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "SystemBase.h"
+#include "../Jobs/JobSystem.h"
+
+/**
+ * The way the systems of a registry are executed
+ * - Serial: the systems are executed one after another on the calling thread in the order of their execution time
+ * - Parallel: systems with the same execution time that do not access the same Components are executed concurrently.
+ *   Systems that do access the same Components are still executed in the same order as in Serial mode.
+ */
+enum class SystemExecution : uint8_t
+{
+	Serial,
+	Parallel,
+};
+
+/**
+ * Executes the systems of a registry, either serially or concurrently on a JobSystem.
+ * Two systems conflict when one of them writes a Component or resource that the other one reads or writes (see SystemBase::GetSystemAccess()).
+ * A Component also conflicts with its sub classes and base classes, as systems acting on a base class can access them.
+ * The systems of every execution time are divided into batches of systems that do not conflict, where each system is placed
+ * in the batch after the last system it conflicts with. The batches are executed in order.
+ * @warning: systems executed in parallel should only access the Components of their access set
+ */
+class SystemScheduler final
+{
+public:
+
+	SystemScheduler(JobSystem* jobSystem) : m_pJobSystem(jobSystem) {}
+
+	SystemScheduler(const SystemScheduler&) = delete;
+	SystemScheduler(SystemScheduler&&) = delete;
+	SystemScheduler& operator=(const SystemScheduler&) = delete;
+	SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+public:
+
+	void SetExecution(SystemExecution execution) { m_Execution = execution; }
+	SystemExecution GetExecution() const { return m_Execution; }
+
+	void SetJobSystem(JobSystem* jobSystem) { m_pJobSystem = jobSystem; }
+	JobSystem* GetJobSystem() const { return m_pJobSystem; }
+
+	/** Amount of threads that execute systems, including the calling thread*/
+	size_t GetThreadAmount() const { return m_pJobSystem->GetThreadAmount() + 1; }
+
+	/** Returns the batches of systems that are executed concurrently. Only valid after executing in Parallel mode*/
+	const std::vector<std::vector<SystemBase*>>& GetBatches() const { return m_Batches; }
+
+	/**
+	 * Calls the update function on every system.
+	 * The systems have to be ordered by their execution time, the schedule is rebuilt after it was invalidated.
+	 */
+	template <typename Systems>
+	void Execute(const Systems& systems, const std::function<void(SystemBase*)>& updateSystem);
+
+	/**
+	 * Rebuilds the schedule before the next execution, has to be called whenever a system is added or removed.
+	 * Comparing the addresses of the systems is not enough, a new system may be allocated at the address of a removed one.
+	 */
+	void Invalidate() { m_IsScheduleValid = false; }
+
+private:
+
+	/** Divides the systems into batches of systems that do not conflict*/
+	void BuildSchedule(std::vector<SystemBase*>&& systems);
+
+	static bool Conflicts(const SystemAccess& access0, const SystemAccess& access1);
+
+	/** Executes the systems on the job system and returns when all of them are done*/
+	void ExecuteBatch(const std::vector<SystemBase*>& batch, const std::function<void(SystemBase*)>& updateSystem);
+
+private:
+
+	SystemExecution m_Execution{ SystemExecution::Serial };
+
+	/** The systems the schedule was built for, in order of execution*/
+	std::vector<SystemBase*> m_ScheduledSystems;
+	std::vector<std::vector<SystemBase*>> m_Batches;
+	bool m_IsScheduleValid{};
+
+	JobSystem* m_pJobSystem{};
+};
+
+template <typename Systems>
+void SystemScheduler::Execute(const Systems& systems, const std::function<void(SystemBase*)>& updateSystem)
+{
+	if (m_Execution == SystemExecution::Serial)
+	{
+		for (auto& system : systems)
+			updateSystem(system.get());
+		return;
+	}
+
+	if (!m_IsScheduleValid)
+	{
+		std::vector<SystemBase*> scheduledSystems;
+		scheduledSystems.reserve(systems.size());
+		for (auto& system : systems)
+			scheduledSystems.emplace_back(system.get());
+
+		BuildSchedule(std::move(scheduledSystems));
+		m_IsScheduleValid = true;
+	}
+
+	for (auto& batch : m_Batches)
+	{
+		if (batch.size() == 1)
+			updateSystem(batch.front());
+		else
+			ExecuteBatch(batch, updateSystem);
+	}
+}
+
@@ -1,5 +1,11 @@
 ﻿#pragma once
+#include <concepts>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
 #include "TypeInformation.h"
+#include "../Registry/Resources.h"
 
 class SystemBase;
 
@@ -27,6 +33,22 @@ concept Initializable = requires(class EntityRegistry* registry, T val) { val.In
 template <typename T>
 concept Sortable = requires(T val0, T val1) { SortCompare(val0, val1); };
 
+/**
+ * If a class contains a public static integral variable called MaxComponents, its TypeView reserves address space for that many Components
+ * and commits it as the view grows, so the Components never move and growing never has to update their references (see PagedArray.h).
+ * The reference pointers, entities and change ticks of the view are kept in reserved address space as well
+ */
+template <typename T>
+concept PagedStorable = std::is_integral_v<decltype(T::MaxComponents)>;
+
+/** If a function exists called SpatialPosition that takes (const T&) and returns a position with an x and y, the Components can be kept in a SpatialIndex*/
+template <typename T>
+concept Spatial = requires(const T& component)
+{
+	{ SpatialPosition(component).x } -> std::convertible_to<float>;
+	{ SpatialPosition(component).y } -> std::convertible_to<float>;
+};
+
 /**
  * Concepts to determine if a type has certain methods that will then automatically be used to create systems from them
  */
@@ -88,6 +110,55 @@ concept isBindingSystem = std::is_base_of_v<SystemBase, Class> && requires(Class
 template <typename Class>
 concept isViewSystem = std::is_base_of_v<SystemBase, Class> && requires(Class sys) { sys.GetTypeView(); };
 
+template <typename Class>
+concept isArchetypeSystem = std::is_base_of_v<SystemBase, Class> && requires(Class sys) { sys.GetArchetypeQuery(); };
+
+
+/**
+ * Concepts for the functions of dynamic systems
+ */
+
+template <typename T>
+struct isStdFunction : std::false_type {};
+
+template <typename Signature>
+struct isStdFunction<std::function<Signature>> : std::true_type {};
+
+/** Sorts the template arguments of a dynamic system into its Components and its resources (see Resource<T>)*/
+template <typename Components, typename Resources, typename... Arguments>
+struct SystemArgumentsSplit
+{
+	using ComponentTypes = Components;
+	using ResourceTypes = Resources;
+};
+
+template <typename... Components, typename... Resources, typename T, typename... Arguments>
+struct SystemArgumentsSplit<std::tuple<Components...>, std::tuple<Resources...>, Resource<T>, Arguments...>
+	: SystemArgumentsSplit<std::tuple<Components...>, std::tuple<Resources..., T>, Arguments...> {};
+
+template <typename... Components, typename... Resources, typename T, typename... Arguments>
+struct SystemArgumentsSplit<std::tuple<Components...>, std::tuple<Resources...>, T, Arguments...>
+	: SystemArgumentsSplit<std::tuple<Components..., T>, std::tuple<Resources...>, Arguments...> {};
+
+template <typename... Arguments>
+using SystemArguments = SystemArgumentsSplit<std::tuple<>, std::tuple<>, Arguments...>;
+
+template <typename Function, typename Components, typename Resources>
+constexpr bool isSystemCallable{ false };
+
+template <typename Function, typename... Components, typename... Resources>
+constexpr bool isSystemCallable<Function, std::tuple<Components...>, std::tuple<Resources...>>{ sizeof...(Components) >= 1
+	&& (std::is_invocable_v<Function&, Components&..., Resources&...> || std::is_invocable_v<Function&, float, Components&..., Resources&...>) };
+
+/**
+ * If the function object can be called with references to the Components followed by references to the resources,
+ * optionally with deltaTime as first parameter.
+ * std::function is excluded as it has its own overloads that do not keep the type of the function.
+ */
+template <typename Function, typename... Arguments>
+concept SystemCallable = !isStdFunction<std::remove_cvref_t<Function>>::value
+	&& isSystemCallable<std::remove_cvref_t<Function>, typename SystemArguments<Arguments...>::ComponentTypes, typename SystemArguments<Arguments...>::ResourceTypes>;
+
 
 /**
  * Concepts for registering Class fields and functions
@@ -96,4 +167,12 @@ concept isViewSystem = std::is_base_of_v<SystemBase, Class> && requires(Class sy
 class ClassMemberAdder;
 
 template <typename Class>
-concept HasMemberInfo = requires(Class t, ClassMemberAdder& adder) { t.RegisterMemberInfo(adder); };
\ No newline at end of file
+concept HasMemberInfo = requires(Class t, ClassMemberAdder& adder) { t.RegisterMemberInfo(adder); };
+
+/**
+ * If a trivially copyable class with registered member variables contains a public static bool StoreAsColumns that is true,
+ * its TypeView stores every registered member variable in its own array instead of storing the Components in a single array (see ColumnView.h)
+ */
+template <typename Class>
+concept ColumnStorable = HasMemberInfo<Class> && std::is_trivially_copyable_v<Class> && !std::is_empty_v<Class>
+	&& requires { requires bool(Class::StoreAsColumns); };
\ No newline at end of file
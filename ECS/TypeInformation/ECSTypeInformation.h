@@ -29,9 +29,16 @@ public:
 	template <typename... Types>
 	static void AddSystem(const SystemParameters& parameters, const std::function<void(float, Types&...)>& function) requires(sizeof...(Types) >= 2);
 
+	/** Registers a dynamic system using a function object of any type, the type of the function is kept inside of the system*/
+	template <typename... Types, typename Function>
+	static void AddSystem(const SystemParameters& parameters, Function&& function) requires SystemCallable<Function, Types...>;
+
 	template <typename System>
 	static void AddSystem(const SystemParameters& parameters) requires (std::is_base_of_v<SystemBase, System>);
 
+	/** Registers a reactive system observing the Component with the given typeId*/
+	static void AddReactiveSystem(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function);
+
 	static void AddDefaultSystems(uint32_t typeId, EntityRegistry* registry);
 
 	static void PrintSystemName(std::ostream& stream);
@@ -41,6 +48,7 @@ public:
 
 	static const std::unordered_map<uint32_t, std::function<TypeViewBase* (EntityRegistry*)>>& GetTypeViewAdders() { return GetInstance().TypeViewAdder; }
 	static const std::unordered_map<std::string, std::function<SystemBase*(EntityRegistry*)>>& GetSystemAdders() { return GetInstance().SystemAdder; }
+	static const std::unordered_map<uint32_t, ArchetypeComponentInfo>& GetArchetypeComponentInfos() { return GetInstance().ArchetypeComponentInfos; }
 
 private:
 
@@ -61,6 +69,7 @@ private:
 	std::unordered_map<uint32_t, std::function<TypeViewBase* (EntityRegistry*)>> TypeViewAdder;
 	std::unordered_map<std::string, std::function<SystemBase* (EntityRegistry*)>> SystemAdder;
 	std::unordered_map<uint32_t, std::vector<std::function<void(EntityRegistry*)>>> DefaultSystemAdders;
+	std::unordered_map<uint32_t, ArchetypeComponentInfo> ArchetypeComponentInfos;
 };
 
 
@@ -72,6 +81,7 @@ void ECSTypeInformation::AddClass()
 		{
 			return &reg->AddView<T>();
 		});
+	instance.ArchetypeComponentInfos.emplace(reflection::type_id<T>(), ArchetypeComponentInfo::Create<T>());
 
 	if constexpr (Updateable<T>)		instance.RegisterUpdateableClass<T>();
 	if constexpr (PreUpdateable<T>)		instance.RegisterPreUpdateableClass<T>();
@@ -118,6 +128,15 @@ void ECSTypeInformation::AddSystem(const SystemParameters& parameters,
 		});
 }
 
+template <typename... Types, typename Function>
+void ECSTypeInformation::AddSystem(const SystemParameters& parameters, Function&& function) requires SystemCallable<Function, Types...>
+{
+	GetInstance().SystemAdder.emplace(parameters.name, [parameters, function = std::remove_cvref_t<Function>(std::forward<Function>(function))](EntityRegistry* reg)
+		{
+			return reg->AddSystem<Types...>(parameters, function);
+		});
+}
+
 template <typename System>
 void ECSTypeInformation::AddSystem(const SystemParameters& parameters) requires (std::is_base_of_v<SystemBase,System>)
 {
@@ -237,6 +256,15 @@ void ECSTypeInformation::RegisterLateRenderableClass()
 		});
 }
 
+inline void ECSTypeInformation::AddReactiveSystem(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event,
+	const std::function<void(EntityRegistry&, entityId)>& function)
+{
+	GetInstance().SystemAdder.emplace(parameters.name, [parameters, typeId, event, function](EntityRegistry* reg)
+		{
+			return reg->AddReactiveSystem(parameters, typeId, event, function);
+		});
+}
+
 inline TypeViewBase* ECSTypeInformation::AddTypeView(uint32_t typeId, EntityRegistry* registry)
 {
 	assert(GetInstance().TypeViewAdder.contains(typeId));
@@ -94,13 +94,52 @@ public:
 		}
 	}
 
+	/** Registers the system using a function object of any type, like a lambda, which can be inlined by the system unlike a std::function*/
+	template <typename Function>
+	RegisterDynamicSystem(const SystemParameters& parameters, Function&& function) requires SystemCallable<Function, Components...>
+	{
+		std::cout << "Registering " << parameters.name << '\n';
+		auto it = Generator.find(parameters.name);
+		if (it == Generator.end())
+		{
+			Generator.emplace(parameters.name, SystemInformationGenerator{ parameters, std::forward<Function>(function) });
+		}
+	}
+
+private:
+	class SystemInformationGenerator final
+	{
+	public:
+		template <typename Function>
+		SystemInformationGenerator(const SystemParameters& parameters, Function&& function)
+		{
+			ECSTypeInformation::AddSystem<Components...>(parameters, std::forward<Function>(function));
+		}
+	};
+	inline static std::unordered_map<std::string, SystemInformationGenerator> Generator{};
+};
+
+/** Registers a reactive system calling the function on every entity the Component with the typeId was added to or removed from*/
+class RegisterReactiveSystem final
+{
+public:
+	RegisterReactiveSystem(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function)
+	{
+		std::cout << "Registering " << parameters.name << '\n';
+		auto it = Generator.find(parameters.name);
+		if (it == Generator.end())
+		{
+			Generator.emplace(parameters.name, SystemInformationGenerator{ parameters, typeId, event, function });
+		}
+	}
+
 private:
 	class SystemInformationGenerator final
 	{
 	public:
-		SystemInformationGenerator(const SystemParameters& parameters, const std::function<void(Components&...)>& function)
+		SystemInformationGenerator(const SystemParameters& parameters, uint32_t typeId, ObserverEvent event, const std::function<void(EntityRegistry&, entityId)>& function)
 		{
-			ECSTypeInformation::AddSystem(parameters, function);
+			ECSTypeInformation::AddReactiveSystem(parameters, typeId, event, function);
 		}
 	};
 	inline static std::unordered_map<std::string, SystemInformationGenerator> Generator{};
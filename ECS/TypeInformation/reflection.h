@@ -3,6 +3,7 @@
 #include <string_view>
 #include <cstdint>
 #include <array>
+#include <type_traits>
 
 //https://stackoverflow.com/questions/35941045/can-i-obtain-c-type-names-in-a-constexpr-way
 
@@ -91,10 +92,11 @@ namespace reflection
 		return wrapped_name.substr(prefix_length, type_name_length);
 	}
 
+	/** const and volatile qualifiers are ignored, so const Components share the typeId of the Component*/
 	template <typename T>
 	constexpr uint32_t type_id()
 	{
-		return hash(type_name<T>());
+		return hash(type_name<std::remove_cv_t<T>>());
 	}
 
 	template <size_t size, typename T, typename... Types>
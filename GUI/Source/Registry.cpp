@@ -172,7 +172,8 @@ void GUI::Registry::DrawEntities()
 			ImGui::SameLine();
 			if (ImGui::Button("Select"))
 			{
-				entityId id = entityId(std::stoull(buffer));
+				// The entities are displayed by their index so get the id with the current generation
+				entityId id = g_pSelectedRegistry->GetEntities().GetIdFromIndex(entityId(std::stoull(buffer)));
 				if (g_pSelectedRegistry->GetEntities().contains(id))
 				{
 					Entities::SetEntity(id, *g_pSelectedRegistry);